@@ -15,10 +15,12 @@
  * * a receiver can be attached with data to pin D5.
 
  * * 13.05.2020 created from receiver.ino
+ * * 16.10.2026 decoding by the SignalDecoder.
  */
 
 #include <Arduino.h>
 #include <SignalCollector.h>
+#include <SignalDecoder.h>
 #include <SignalParser.h>
 
 #include <protocols.h>
@@ -28,56 +30,26 @@ SignalCollector col;
 
 // ===== Cresta protocol decoding =====
 
-// This function can be used to decode the Cresta Manchester protocol.
+// The SignalDecoder decodes the Cresta Manchester protocol into the data bytes,
+// the temperature and the humidity.
 
-void cresta_decode(const char *p)
+SignalDecoder dec;
+
+// This function will be called when a sequence was decoded.
+void receiveRecord(const SignalDecoder::Record *rec)
 {
-  uint8_t cresta_data[10]; // our device emits 10+2 data bytes, we only read the 10 and ignore the checksum
-  int cresta_cnt = 0;      // number of received bytes
-
-  uint8_t cresta_byte = 0; // currenty byte value fom the stream
-  uint8_t cresta_bits = 0; // next bit to receive. 0..7, 8 is the 0-bit used inbetween data baytes
-
-  // simulate shifting in bits from header : 10101
-  cresta_byte = 0x15;
-  cresta_bits = 5;
-  bool bit = 1; // last bit was HIGH
-
-  while (*p) {
-    if (*p == 'l') {
-      bit = 1 - bit;
-    }
-    p++;
-
-    if (cresta_bits < 8) {
-      // shift bit into data byte
-      cresta_byte |= bit << cresta_bits;
-      cresta_bits++;
-    } else {
-      // shift completed byte into buffer
-      // bit must be 0, not verified
-      cresta_byte = cresta_byte ^ (cresta_byte << 1); // decode
-      cresta_data[cresta_cnt++] = cresta_byte;
-      // reset for next byte
-      cresta_bits = 0;
-      cresta_byte = 0;
-    }
-  } // while
-
-  // print received data
-  Serial.print("data:");
-  for (int i = 0; i < 7; i++) {
-    if (cresta_data[i] < 16) Serial.print("0");
-    Serial.print(cresta_data[i], 16);
-    Serial.print(" ");
-  } // for
-  Serial.println();
+  if (rec->type == SignalDecoder::CW) {
+    // print received data
+    Serial.print("data:");
+    for (int i = 0; i < 7; i++) {
+      if (rec->cw.data[i] < 16) Serial.print("0");
+      Serial.print(rec->cw.data[i], 16);
+      Serial.print(" ");
+    } // for
+    Serial.println();
 
-  if (cresta_data[0] != 0x9f) {
-    Serial.println("Bad data.");
-  } else {
     // temperature
-    int temp = 100 * (cresta_data[5] & 0x0f) + 10 * (cresta_data[4] >> 4) + (cresta_data[4] & 0x0f);
+    int temp = rec->cw.temperature;
     Serial.print("  temp: ");
     Serial.print(temp / 10);
     Serial.print('.');
@@ -85,12 +57,11 @@ void cresta_decode(const char *p)
     Serial.println(" °C");
 
     // humidity
-    int hum = 10 * (cresta_data[6] >> 4) + (cresta_data[6] & 0x0f);
     Serial.print("   hum: ");
-    Serial.print(hum);
+    Serial.print(rec->cw.humidity);
     Serial.println(" %");
   }
-} // cresta_decode
+} // receiveRecord()
 
 
 // This function will be called when a complete protcol was received.
@@ -99,10 +70,6 @@ void receiveCode(const char *proto)
   Serial.print("received [");
   Serial.print(proto);
   Serial.println("]");
-
-  if (strncmp(proto, "cw ", 3) == 0) {
-    cresta_decode(proto + 4);
-  }
 } // receiveCode()
 
 
@@ -122,6 +89,11 @@ void setup()
   col.init(&sig, D5, NO_PIN); // input at pin D5, no output
 
   sig.attachCallback(receiveCode);
+
+  // decode the data of the sensor
+  dec.attach(&RFCodes::cw, SignalDecoder::decodeCw);
+  dec.attachRecordCallback(receiveRecord);
+  sig.attachDecoder(&dec);
 } // setup()
 
 
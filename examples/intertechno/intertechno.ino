@@ -29,65 +29,29 @@ bool showRaw = false;
 SignalParser sig;
 SignalCollector col;
 
-// ===== Cresta protocol decoding =====
+// ===== Decoding the values =====
 
-// This function can be used to decode the Cresta Manchester protocol.
-// See /docs/cresta_potocol.md for further details.
+// The SignalDecoder decodes the sequences of the loaded protocols into values.
+SignalDecoder dec;
 
-void cresta_decode(const char *p)
+// This function will be called when a sequence was decoded.
+void receiveRecord(const SignalDecoder::Record *rec)
 {
-  uint8_t cresta_data[10]; // our device emits 10+2 data bytes, we only read the 10 and ignore the checksum
-  int cresta_cnt = 0;      // number of received bytes
-
-  uint8_t cresta_byte = 0; // currenty byte value fom the stream
-  uint8_t cresta_bits = 0; // next bit to receive. 0..7, 8 is the 0-bit used inbetween data baytes
-
-  // simulate shifting in bits from header : 10101
-  cresta_byte = 0x15;
-  cresta_bits = 5;
-  bool bit = 1; // last bit was HIGH
-
-  while (*p) {
-    if (*p == 'l') {
-      bit = 1 - bit;
-    }
-    p++;
-
-    if (cresta_bits < 8) {
-      // shift bit into data byte
-      cresta_byte |= bit << cresta_bits;
-      cresta_bits++;
-    } else {
-      // shift completed byte into buffer
-      // bit must be 0, not verified
-      cresta_byte = cresta_byte ^ (cresta_byte << 1); // decode
-      cresta_data[cresta_cnt++] = cresta_byte;
-      // reset for next byte
-      cresta_bits = 0;
-      cresta_byte = 0;
-    }
-  } // while
-
-  // print received data
-  Serial.print("data:");
-  for (int i = 0; i < 7; i++) {
-    Serial.printf("%02x ", cresta_data[i]);
-  } // for
-  Serial.println();
-
-  if (cresta_data[0] != 0x9f) {
-    Serial.println("Bad data.");
-  } else {
-    // temperature
-    int temp = 100 * (cresta_data[5] & 0x0f) + 10 * (cresta_data[4] >> 4) + (cresta_data[4] & 0x0f);
-    Serial.printf("  temp: %d.%d °C\n", temp / 10, temp % 10);
-
-    // humidity
-    int hum = 10 * (cresta_data[6] >> 4) + (cresta_data[6] & 0x0f);
-    Serial.printf("  hum : %d %%\n", hum);
+  if (rec->type == SignalDecoder::IT2) {
+    Serial.printf("  it2 address: %07lx unit: %u %s%s\n", rec->it2.address, rec->it2.unit,
+                  rec->it2.on ? "on" : "off", rec->it2.group ? " group" : "");
+
+  } else if (rec->type == SignalDecoder::CW) {
+    // print received data
+    Serial.print("data:");
+    for (int i = 0; i < 7; i++) {
+      Serial.printf("%02x ", rec->cw.data[i]);
+    } // for
+    Serial.println();
+    Serial.printf("  temp: %d.%d °C\n", rec->cw.temperature / 10, rec->cw.temperature % 10);
+    Serial.printf("  hum : %d %%\n", rec->cw.humidity);
   }
-
-} // cresta_decode
+} // receiveRecord()
 
 
 // This function will be called when a complete protcol was received.
@@ -116,10 +80,6 @@ void receiveCode(const char *proto)
     } // while
     Serial.println();
   } // if
-
-  if (strncmp(proto, "cw ", 3) == 0) {
-    cresta_decode(proto + 4);
-  }
 } // receiveCode()
 
 
@@ -151,6 +111,10 @@ void setup()
     Serial.println("Raw mode is disabled");
 
   sig.attachCallback(receiveCode);
+
+  dec.attachAll();
+  dec.attachRecordCallback(receiveRecord);
+  sig.attachDecoder(&dec);
 } // setup()
 
 
@@ -11,12 +11,14 @@
   codes.
 
   05.06.2020 created
+  16.10.2026 held buttons reported by the SignalDecoder.
 */
 
 #include <Arduino.h>
 #include <SignalCollector.h>
 #include <ircodes.h>
 
+#include <SignalDecoder.h>
 #include <SignalParser.h>
 
 
@@ -24,6 +26,7 @@ bool showRaw = false;
 
 SignalParser sig;
 SignalCollector tabRF;
+SignalDecoder dec;
 
 // This function will be called when a complete protcol was received.
 void receiveCode(const char *proto)
@@ -55,6 +58,16 @@ void receiveCode(const char *proto)
   } // if
 } // receiveCode()
 
+// This function will be called with the decoded commands and the repeats while a button is held.
+void receiveRecord(const SignalDecoder::Record *rec)
+{
+  if (rec->nec.repeat) {
+    Serial.printf("nec %04x:%02x held %lu ms (%d)\n", rec->nec.address, rec->nec.command, rec->nec.held, rec->nec.repeat);
+  } else {
+    Serial.printf("nec %04x:%02x\n", rec->nec.address, rec->nec.command);
+  }
+} // receiveRecord()
+
 void setup()
 {
   delay(2000);
@@ -75,6 +88,12 @@ void setup()
     Serial.println("Raw mode is disabled");
 
   sig.attachCallback(receiveCode);
+
+  // report a held button after 300 msecs and then every 100 msecs.
+  dec.attach(&IRCodes::nec, SignalDecoder::decodeNec);
+  dec.setNecRepeat(300, 100);
+  dec.attachRecordCallback(receiveRecord);
+  sig.attachDecoder(&dec);
 } // setup()
 
 
@@ -87,7 +87,7 @@ SignalParser::CodeTime testdata[] = {
     1044, 918, 1021, 940, 1003,
     462, 509, 470, 492, 980, 486, 487, 972, 987, 477, 506, 456, 525, 945, 1007, 456, 533, 436, 533, 440, 535, 448, 531, 925, 1023, 935, 539, 438, 531, 440, 1028, 931, 1014, 447, 535, 930, 1028, 924, 1027, 437, 548, 441, 526, 924, 1038, 431, 536, 439, 535, 447, 538,
     926, 1019, 941, 1016, 439, 537, 445, 533, 927, 530, 446, 536, 438, 536, 443, 533, 451, 535, 440, 1015, 934, 1020, 930, 537, 443, 1028, 436, 530, 450, 532, 442, 535, 437, 537, 450, 530, 444, 535,
-    // find: [cw Hsslsllssllsssslllsslllsllllssllsssllllsslsssssllllslssssss]
+    // find: [cw H1100100010000010111010010100010000101000111111010110000000]
 
     /* noise */ 941, 1016, 439, 537,
 
@@ -103,7 +103,7 @@ const char *testresult[] = {
     "sc5 000100000001S",
     "it2 s_##__##__#__####____##__#_______x",
     "it2 s_##__##__#__####____##__#______#x",
-    "cw Hsslsllssllsssslllsslllsllllssllsssllllsslsssssllllslssssss",
+    "cw H1100100010000010111010010100010000101000111111010110000000",
     ""};
 
 int nextResult;
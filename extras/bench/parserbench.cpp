@@ -0,0 +1,287 @@
+/**
+ * @file parserbench.cpp
+ *
+ * This file is part of the RFCodes library that implements receiving an sending
+ * RF and IR protocols.
+ *
+ * @copyright Copyright (c) by Matthias Hertel, https://www.mathertel.de.
+ *
+ * This work is licensed under a BSD 3-Clause style license,
+ * https://www.mathertel.de/License.aspx.
+ *
+ * @brief
+ * Microbenchmark of SignalParser::parse().
+ *
+ * The stream is built from the testcodes.ino data and the scanner recording
+ * from docs/scanner.md. Three sweeps are measured:
+ * * protocols: number of loaded protocols from 1 to 64
+ * * noise: fraction of random noise durations, inserted between the frames
+ * * codes: number of codes per protocol
+ *
+ * The results are printed as CSV or JSON lines with the ns per duration and
+ * the frames per second.
+ *
+ * Changelog:
+ * * 16.10.2026 created.
+ */
+
+#include <chrono>
+#include <math.h>
+#include <random>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include <vector>
+
+#include "SignalParser.h"
+
+#include "ProtocolTable.h"
+#include "SampleData.h"
+
+static unsigned long frameCount = 0;
+static unsigned long frameEnd = 0; // index of the duration that completed the last frame
+static std::vector<unsigned long> frameEnds;
+
+static void countFrame(const char *)
+{
+  frameCount++;
+} // countFrame()
+
+static void recordFrame(const char *)
+{
+  frameEnds.push_back(frameEnd);
+} // recordFrame()
+
+
+// build the benchmark stream with the given fraction of noise durations.
+// The noise is inserted as bursts between the frames of the recorded data.
+static void buildStream(double noise, std::vector<SignalParser::CodeTime> &stream)
+{
+  std::mt19937 rnd(1);
+  std::uniform_real_distribution<double> uniform(0.0, 1.0);
+
+  std::vector<SignalParser::CodeTime> real;
+  for (const SignalParser::CodeTime *t = SampleData::testcodes; *t; t++)
+    real.push_back(*t);
+  for (const SignalParser::CodeTime *t = SampleData::scanner; *t; t++)
+    real.push_back(*t);
+
+  // find the frame ends using all known protocols.
+  SignalParser sig;
+  ProtocolTable::load(&sig, nullptr);
+  sig.attachCallback(recordFrame);
+  frameEnds.clear();
+  for (frameEnd = 0; frameEnd < real.size(); frameEnd++)
+    sig.parse(real[frameEnd]);
+  frameEnds.push_back(real.size() - 1);
+
+  // spread the noise durations over the gaps after the frames.
+  size_t noiseCount = (size_t)(real.size() * noise / (1 - noise));
+  size_t burstSize = (noiseCount + frameEnds.size() - 1) / frameEnds.size();
+
+  stream.clear();
+  size_t f = 0;
+  for (size_t n = 0; n < real.size(); n++) {
+    stream.push_back(real[n]);
+
+    if ((f < frameEnds.size()) && (frameEnds[f] == n)) {
+      f++;
+      for (size_t i = 0; (i < burstSize) && noiseCount; i++, noiseCount--) {
+        // log-uniform noise between 20 and 20000 µsecs
+        stream.push_back((SignalParser::CodeTime)(20.0 * pow(1000.0, uniform(rnd))));
+      }
+    }
+  } // for
+} // buildStream()
+
+
+// count the codes of a protocol definition that is not loaded yet.
+static int definedCodes(const SignalParser::Protocol *p)
+{
+  int cnt = 0;
+  while ((cnt < MAX_CODELENGTH) && p->codes[cnt].name)
+    cnt++;
+  return (cnt);
+} // definedCodes()
+
+
+// create copies of the known protocols.
+// @param count number of protocols, the known protocols are used in rotation.
+// @param codes number of codes per protocol or 0 to use the original code tables.
+static void makeProtocols(int count, int codes, std::vector<SignalParser::Protocol> &protocols)
+{
+  int known = 0;
+  while (ProtocolTable::all[known].name)
+    known++;
+
+  protocols.clear();
+  for (int n = 0; n < count; n++) {
+    SignalParser::Protocol p = *ProtocolTable::all[n % known].protocol;
+
+    if (codes > 0) {
+      // cut or extend the code table with additional data codes.
+      int cl = definedCodes(&p);
+      if (cl > codes)
+        cl = codes;
+      for (int c = cl; c < MAX_CODELENGTH; c++) {
+        memset(&p.codes[c], 0, sizeof(SignalParser::Code));
+        if (c < codes) {
+          p.codes[c].type = SignalParser::CodeType::DATA;
+          p.codes[c].name = 'a' + c;
+          p.codes[c].time[0] = 1;
+          p.codes[c].time[1] = 2 + c;
+        }
+      } // for
+    } // if
+    protocols.push_back(p);
+  } // for
+} // makeProtocols()
+
+
+struct Result {
+  const char *sweep;
+  int protocols;
+  double codes; // average number of codes per protocol
+  double noise;
+  unsigned long durations;
+  unsigned long frames;
+  double nsPerDuration;
+  double framesPerSec;
+};
+
+
+// run the stream repeatedly through a parser with the protocols for at least minTime.
+static Result measure(std::vector<SignalParser::Protocol> &protocols,
+                      const std::vector<SignalParser::CodeTime> &stream, double minTime)
+{
+  SignalParser sig;
+  int codes = 0;
+  for (auto &p : protocols) {
+    sig.load(&p);
+    codes += p.codeLength;
+  }
+  sig.attachCallback(countFrame);
+
+  Result r = {};
+  r.protocols = (int)protocols.size();
+  r.codes = (double)codes / protocols.size();
+
+  frameCount = 0;
+  double elapsed = 0;
+  auto start = std::chrono::steady_clock::now();
+  do {
+    for (SignalParser::CodeTime t : stream)
+      sig.parse(t);
+    r.durations += stream.size();
+    elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  } while (elapsed < minTime);
+
+  r.frames = frameCount;
+  r.nsPerDuration = elapsed * 1e9 / r.durations;
+  r.framesPerSec = r.frames / elapsed;
+  return (r);
+} // measure()
+
+
+static bool jsonOutput = false;
+
+static void printHeader()
+{
+  if (!jsonOutput)
+    printf("sweep,protocols,codes,noise,durations,frames,ns_per_duration,frames_per_sec\n");
+} // printHeader()
+
+
+static void printResult(const Result &r)
+{
+  if (jsonOutput) {
+    printf("{\"sweep\":\"%s\",\"protocols\":%d,\"codes\":%.2f,\"noise\":%.2f,\"durations\":%lu,"
+           "\"frames\":%lu,\"ns_per_duration\":%.2f,\"frames_per_sec\":%.1f}\n",
+           r.sweep, r.protocols, r.codes, r.noise, r.durations, r.frames, r.nsPerDuration, r.framesPerSec);
+  } else {
+    printf("%s,%d,%.2f,%.2f,%lu,%lu,%.2f,%.1f\n",
+           r.sweep, r.protocols, r.codes, r.noise, r.durations, r.frames, r.nsPerDuration, r.framesPerSec);
+  }
+  fflush(stdout);
+} // printResult()
+
+
+static void usage()
+{
+  fprintf(stderr,
+          "usage: parserbench [-s sweep] [-t ms] [-j]\n"
+          "  -s  sweep to run: protocols, noise, codes or all, default: all\n"
+          "  -t  minimal measuring time per result in msecs, default: 200\n"
+          "  -j  print JSON lines instead of CSV\n");
+} // usage()
+
+
+int main(int argc, char *argv[])
+{
+  const char *sweep = "all";
+  double minTime = 0.2;
+  int opt;
+
+  while ((opt = getopt(argc, argv, "s:t:jh")) != -1) {
+    if (opt == 's') {
+      sweep = optarg;
+    } else if (opt == 't') {
+      minTime = atof(optarg) / 1000;
+    } else if (opt == 'j') {
+      jsonOutput = true;
+    } else {
+      usage();
+      return (2);
+    }
+  } // while
+
+  bool all = (strcmp(sweep, "all") == 0);
+  if (!all && strcmp(sweep, "protocols") && strcmp(sweep, "noise") && strcmp(sweep, "codes")) {
+    usage();
+    return (2);
+  }
+
+  std::vector<SignalParser::CodeTime> stream;
+  std::vector<SignalParser::Protocol> protocols;
+  int known = 0;
+  while (ProtocolTable::all[known].name)
+    known++;
+
+  printHeader();
+
+  if (all || (strcmp(sweep, "protocols") == 0)) {
+    buildStream(0, stream);
+    for (int cnt = 1; cnt <= 64; cnt *= 2) {
+      makeProtocols(cnt, 0, protocols);
+      Result r = measure(protocols, stream, minTime);
+      r.sweep = "protocols";
+      printResult(r);
+    }
+  } // if
+
+  if (all || (strcmp(sweep, "noise") == 0)) {
+    static const double noiseLevels[] = {0, 0.1, 0.25, 0.5, 0.75, 0.9};
+    for (double noise : noiseLevels) {
+      buildStream(noise, stream);
+      makeProtocols(known, 0, protocols);
+      Result r = measure(protocols, stream, minTime);
+      r.sweep = "noise";
+      r.noise = noise;
+      printResult(r);
+    }
+  } // if
+
+  if (all || (strcmp(sweep, "codes") == 0)) {
+    buildStream(0, stream);
+    for (int codes = 1; codes <= MAX_CODELENGTH; codes++) {
+      makeProtocols(known, codes, protocols);
+      Result r = measure(protocols, stream, minTime);
+      r.sweep = "codes";
+      printResult(r);
+    }
+  } // if
+
+  return (0);
+} // main()
+
+// End.
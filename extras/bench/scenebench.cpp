@@ -0,0 +1,205 @@
+/**
+ * @file scenebench.cpp
+ *
+ * This file is part of the RFCodes library that implements receiving an sending
+ * RF and IR protocols.
+ *
+ * @copyright Copyright (c) by Matthias Hertel, https://www.mathertel.de.
+ *
+ * This work is licensed under a BSD 3-Clause style license,
+ * https://www.mathertel.de/License.aspx.
+ *
+ * @brief
+ * Latency of sending a scene of many codes through the transmit queue.
+ *
+ * All codes of the scene are queued at once by SignalCollector::send() and
+ * sent using the simulation backend. The sent signal is decoded again to find
+ * the time when every code was received the first time. The result is
+ * compared to sending all repeats of every code back to back like the former
+ * blocking send() did.
+ *
+ * Changelog:
+ * * 16.10.2026 created.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <unistd.h>
+#include <vector>
+
+#include "SignalCollector.h"
+#include "SignalHalSim.h"
+
+#include "ProtocolTable.h"
+#include "SignalGenerator.h"
+
+#define SEND_PIN 1
+
+struct SceneCode {
+  std::string code;
+  unsigned long frameTime;     // duration of a single copy without gap.
+  unsigned long received = 0;  // time the code was decoded the first time.
+  unsigned long completed = 0; // time the sent callback reported the code.
+  int decoded = 0;
+};
+
+static SignalParser sig;
+static SignalCollector col;
+static std::vector<SceneCode> scene;
+static unsigned long lastEdge = 0;
+static bool started = false;
+
+
+static SceneCode *findCode(const char *code)
+{
+  for (SceneCode &c : scene) {
+    if (c.code == code)
+      return (&c);
+  }
+  return (nullptr);
+} // findCode()
+
+
+static void receiveCode(const char *code)
+{
+  SceneCode *c = findCode(code);
+  if (c) {
+    if (c->decoded == 0)
+      c->received = SignalHalSim::now();
+    c->decoded++;
+  }
+} // receiveCode()
+
+
+static void codeSent(const char *code, const SignalTransmitter::SendInfo *info)
+{
+  SceneCode *c = findCode(code);
+  if (c)
+    c->completed = info->completed;
+} // codeSent()
+
+
+// decode the durations between the edges of the send pin.
+static void outputEdge(int pin, int, unsigned long now)
+{
+  if (pin == SEND_PIN) {
+    if (started)
+      sig.parse((SignalParser::CodeTime)(now - lastEdge));
+    lastEdge = now;
+    started = true;
+  }
+} // outputEdge()
+
+
+static void usage()
+{
+  fprintf(stderr,
+          "usage: scenebench [options]\n"
+          "  -p list   comma separated list of protocols, default: it1\n"
+          "  -n count  number of codes in the scene, default: 10\n"
+          "  -s seed   seed of the random generator, default: 1\n");
+} // usage()
+
+
+int main(int argc, char *argv[])
+{
+  const char *protocols = "it1";
+  int count = 10;
+  unsigned long seed = 1;
+  int opt;
+
+  while ((opt = getopt(argc, argv, "p:n:s:h")) != -1) {
+    if (opt == 'p') {
+      protocols = optarg;
+    } else if (opt == 'n') {
+      count = atoi(optarg);
+    } else if (opt == 's') {
+      seed = strtoul(optarg, nullptr, 0);
+    } else {
+      usage();
+      return (2);
+    }
+  } // while
+
+  SignalParser::Protocol *list[32];
+  int protCount = ProtocolTable::select(protocols, list, 32);
+  if (protCount <= 0) {
+    fprintf(stderr, "scenebench: unknown protocol in '%s'\n", protocols);
+    return (2);
+  }
+  if ((count < 1) || (count > ST_QUEUE_SIZE)) {
+    fprintf(stderr, "scenebench: the scene must have 1 - %d codes\n", ST_QUEUE_SIZE);
+    return (2);
+  }
+
+  for (int n = 0; n < protCount; n++) {
+    sig.load(list[n]);
+  }
+  sig.attachCallback(receiveCode);
+
+  // create the scene and calculate the former blocking schedule.
+  SignalGenerator gen(seed);
+  unsigned long blockingTime = 0;
+  unsigned long blockingLatency = 0;
+
+  for (int n = 0; n < count; n++) {
+    SignalParser::Protocol *p = list[n % protCount];
+    SceneCode c;
+    c.code = p->name;
+    c.code += ' ';
+    c.code += gen.randomCodes(p);
+
+    std::vector<SignalParser::CodeTime> timings(sig.compose(c.code.c_str(), nullptr, 0) + 1);
+    sig.compose(c.code.c_str(), timings.data(), (int)timings.size());
+    c.frameTime = 0;
+    for (SignalParser::CodeTime t : timings) {
+      c.frameTime += t;
+    }
+
+    if (blockingTime + c.frameTime > blockingLatency)
+      blockingLatency = blockingTime + c.frameTime;
+    blockingTime += c.frameTime * p->sendRepeat;
+    scene.push_back(c);
+  } // for
+
+  // send the scene through the queue.
+  SignalHalSim::reset();
+  col.init(&sig, NO_PIN, SEND_PIN);
+  col.attachSentCallback(codeSent);
+  SignalHalSim::setOutputHook(outputEdge);
+
+  for (SceneCode &c : scene) {
+    col.send(c.code.c_str());
+  }
+  printf("queue depth: %d\n", col.getQueueDepth());
+
+  while (col.isSending()) {
+    while (SignalHalSim::runTimer()) {
+      // the edges are written by the timer.
+    }
+    col.loop();
+  }
+
+  unsigned long latency = 0;
+  unsigned long total = 0;
+  int missing = 0;
+
+  printf("code                                              received  completed  decoded\n");
+  for (SceneCode &c : scene) {
+    printf("%-48s %7.1fms %8.1fms %8d\n", c.code.c_str(), c.received / 1000.0, c.completed / 1000.0, c.decoded);
+    if (c.received > latency)
+      latency = c.received;
+    if (c.completed > total)
+      total = c.completed;
+    if (c.decoded == 0)
+      missing++;
+  } // for
+
+  printf("scene latency: %.1f ms queued, %.1f ms blocking\n", latency / 1000.0, blockingLatency / 1000.0);
+  printf("total time:    %.1f ms queued, %.1f ms blocking\n", total / 1000.0, blockingTime / 1000.0);
+  return (missing ? 1 : 0);
+} // main()
+
+// End.
@@ -0,0 +1,275 @@
+/**
+ * @file sensitivitybench.cpp
+ *
+ * This file is part of the RFCodes library that implements receiving an sending
+ * RF and IR protocols.
+ *
+ * @copyright Copyright (c) by Matthias Hertel, https://www.mathertel.de.
+ *
+ * This work is licensed under a BSD 3-Clause style license,
+ * https://www.mathertel.de/License.aspx.
+ *
+ * @brief
+ * Decode rate vs. noise benchmark.
+ *
+ * For every protocol a synthetic stream is generated by the SignalGenerator
+ * with a sweep of the jitter and the noise density. The stream is decoded
+ * using parser configurations with different tolerance values and with the
+ * protocol loaded alone or together with all other protocols.
+ *
+ * Every result reports the decode rate, the false positive rate and the CPU
+ * cost per duration as CSV or JSON lines for plotting the sensitivity curves.
+ *
+ * Changelog:
+ * * 16.10.2026 created.
+ */
+
+#include <chrono>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <unistd.h>
+#include <vector>
+
+#include "SignalParser.h"
+
+#include "ProtocolTable.h"
+#include "SignalGenerator.h"
+
+#define SILENCE_TIME 30000 // silence in µsecs before every frame
+
+struct Decoded {
+  size_t end; // index of the duration that completed the frame
+  std::string code;
+};
+
+static size_t streamPos = 0;
+static bool collect = false;
+static std::vector<Decoded> decoded;
+
+static void receiveCode(const char *code)
+{
+  if (collect)
+    decoded.push_back({streamPos, code});
+} // receiveCode()
+
+
+struct Result {
+  const char *protocol;
+  unsigned int tolerance;
+  const char *loaded; // "alone" or "all"
+  double jitter;
+  double noise;
+  size_t frames;
+  size_t matched;
+  size_t falsePositives;
+  double nsPerDuration;
+};
+
+
+// compare the decoded frames with the expected frames.
+static void evaluate(const std::vector<SignalGenerator::Frame> &expected, Result &r)
+{
+  std::vector<bool> used(decoded.size(), false);
+  size_t d = 0;
+
+  r.frames = expected.size();
+  r.matched = 0;
+
+  for (const SignalGenerator::Frame &f : expected) {
+    // skip decoded frames before this frame
+    while ((d < decoded.size()) && (decoded[d].end < f.offset))
+      d++;
+
+    for (size_t n = d; (n < decoded.size()) && (decoded[n].end <= f.end + 2); n++) {
+      if (!used[n] && (decoded[n].code == f.code)) {
+        used[n] = true;
+        r.matched++;
+        break;
+      }
+    } // for
+  } // for
+
+  r.falsePositives = 0;
+  for (bool u : used) {
+    if (!u)
+      r.falsePositives++;
+  }
+} // evaluate()
+
+
+// decode the stream with the configuration for at least minTime.
+static void measure(const char *protName, unsigned int tolerance, bool loadAll,
+                    const std::vector<SignalParser::CodeTime> &stream, double minTime, Result &r)
+{
+  // copies of the protocols with the tolerance for the tested protocol.
+  std::vector<SignalParser::Protocol> protocols;
+  protocols.reserve(32);
+  for (const ProtocolTable::Entry *e = ProtocolTable::all; e->name; e++) {
+    if (strcmp(e->name, protName) == 0) {
+      protocols.push_back(*e->protocol);
+      if (tolerance)
+        protocols.back().tolerance = tolerance;
+    } else if (loadAll) {
+      protocols.push_back(*e->protocol);
+    }
+  } // for
+
+  SignalParser sig;
+  for (auto &p : protocols)
+    sig.load(&p);
+  sig.attachCallback(receiveCode);
+
+  decoded.clear();
+  collect = true;
+  size_t durations = 0;
+  double elapsed = 0;
+  auto start = std::chrono::steady_clock::now();
+  do {
+    sig.reset();
+    for (streamPos = 0; streamPos < stream.size(); streamPos++)
+      sig.parse(stream[streamPos]);
+    durations += stream.size();
+    collect = false; // the first run is evaluated
+    elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  } while (elapsed < minTime);
+
+  r.tolerance = tolerance ? tolerance : ProtocolTable::find(protName)->tolerance;
+  r.loaded = loadAll ? "all" : "alone";
+  r.nsPerDuration = elapsed * 1e9 / durations;
+} // measure()
+
+
+static bool jsonOutput = false;
+
+static void printResult(const Result &r)
+{
+  double rate = r.frames ? (double)r.matched / r.frames : 0;
+  double fpRate = r.frames ? (double)r.falsePositives / r.frames : 0;
+
+  if (jsonOutput) {
+    printf("{\"protocol\":\"%s\",\"tolerance\":%u,\"loaded\":\"%s\",\"jitter\":%.1f,\"noise\":%.1f,"
+           "\"frames\":%zu,\"decoded\":%zu,\"false_positives\":%zu,\"decode_rate\":%.4f,"
+           "\"false_positive_rate\":%.4f,\"ns_per_duration\":%.2f}\n",
+           r.protocol, r.tolerance, r.loaded, r.jitter, r.noise, r.frames, r.matched,
+           r.falsePositives, rate, fpRate, r.nsPerDuration);
+  } else {
+    printf("%s,%u,%s,%.1f,%.1f,%zu,%zu,%zu,%.4f,%.4f,%.2f\n",
+           r.protocol, r.tolerance, r.loaded, r.jitter, r.noise, r.frames, r.matched,
+           r.falsePositives, rate, fpRate, r.nsPerDuration);
+  }
+  fflush(stdout);
+} // printResult()
+
+
+// parse a comma separated list of numbers.
+static std::vector<double> numberList(const char *list)
+{
+  std::vector<double> values;
+  while (list && *list) {
+    char *end;
+    values.push_back(strtod(list, &end));
+    list = (*end == ',') ? end + 1 : "";
+  }
+  return (values);
+} // numberList()
+
+
+static void usage()
+{
+  fprintf(stderr,
+          "usage: sensitivitybench [options]\n"
+          "  -p list  comma separated list of protocols, default: it1,it2,sc5,cw,nec,rc5\n"
+          "  -J list  jitter values in percent, default: 0,2,5,8,10,15,20\n"
+          "  -Z list  average noise durations between frames, default: 0,5,20,50\n"
+          "  -T list  tolerance values in percent, 0 for the protocol default, default: 0\n"
+          "  -a       also decode with all protocols loaded\n"
+          "  -n count frames per stream, default: 200\n"
+          "  -s seed  seed of the random generator, default: 1\n"
+          "  -t ms    minimal measuring time per result in msecs, default: 20\n"
+          "  -j       print JSON lines instead of CSV\n");
+} // usage()
+
+
+int main(int argc, char *argv[])
+{
+  const char *protocols = "it1,it2,sc5,cw,nec,rc5";
+  std::vector<double> jitters = numberList("0,2,5,8,10,15,20");
+  std::vector<double> noises = numberList("0,5,20,50");
+  std::vector<double> tolerances = numberList("0");
+  bool withAll = false;
+  int count = 200;
+  unsigned long seed = 1;
+  double minTime = 0.02;
+  int opt;
+
+  while ((opt = getopt(argc, argv, "p:J:Z:T:an:s:t:jh")) != -1) {
+    if (opt == 'p') {
+      protocols = optarg;
+    } else if (opt == 'J') {
+      jitters = numberList(optarg);
+    } else if (opt == 'Z') {
+      noises = numberList(optarg);
+    } else if (opt == 'T') {
+      tolerances = numberList(optarg);
+    } else if (opt == 'a') {
+      withAll = true;
+    } else if (opt == 'n') {
+      count = atoi(optarg);
+    } else if (opt == 's') {
+      seed = strtoul(optarg, nullptr, 0);
+    } else if (opt == 't') {
+      minTime = atof(optarg) / 1000;
+    } else if (opt == 'j') {
+      jsonOutput = true;
+    } else {
+      usage();
+      return (2);
+    }
+  } // while
+
+  SignalParser::Protocol *list[32];
+  int protCount = ProtocolTable::select(protocols, list, 32);
+  if (protCount <= 0) {
+    fprintf(stderr, "sensitivitybench: unknown protocol in '%s'\n", protocols);
+    return (2);
+  }
+
+  if (!jsonOutput)
+    printf("protocol,tolerance,loaded,jitter,noise,frames,decoded,false_positives,decode_rate,false_positive_rate,ns_per_duration\n");
+
+  SignalGenerator gen;
+
+  for (int n = 0; n < protCount; n++) {
+    const SignalParser::Protocol *p = list[n];
+
+    for (double noise : noises) {
+      for (double jitter : jitters) {
+        SignalGenerator::Config config;
+        config.jitter = jitter;
+        config.noiseGap = noise;
+        config.silence = SILENCE_TIME;
+        gen.clear(seed);
+        gen.setConfig(config);
+        gen.addRandomFrames(p, count);
+
+        for (double tolerance : tolerances) {
+          for (int loadAll = 0; loadAll <= (withAll ? 1 : 0); loadAll++) {
+            Result r = {};
+            r.protocol = p->name;
+            r.jitter = jitter;
+            r.noise = noise;
+            measure(p->name, (unsigned int)tolerance, loadAll, gen.stream(), minTime, r);
+            evaluate(gen.frames(), r);
+            printResult(r);
+          } // for
+        } // for
+      } // for
+    } // for
+  } // for
+
+  return (0);
+} // main()
+
+// End.
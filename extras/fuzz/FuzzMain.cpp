@@ -0,0 +1,85 @@
+/**
+ * @file FuzzMain.cpp
+ *
+ * This file is part of the RFCodes library that implements receiving an sending
+ * RF and IR protocols.
+ *
+ * @copyright Copyright (c) by Matthias Hertel, https://www.mathertel.de.
+ *
+ * This work is licensed under a BSD 3-Clause style license,
+ * https://www.mathertel.de/License.aspx.
+ *
+ * @brief
+ * Standalone driver for the fuzzing harnesses when libFuzzer is not available.
+ *
+ * * With file arguments every file is passed once to the harness. This is
+ *   compatible with AFL using "@@" or reading the input from stdin.
+ * * With "-r count" random inputs are generated, optionally with "-s seed".
+ *   This gives sustained hostile input using the sanitizers of gcc.
+ *
+ * Changelog:
+ * * 16.10.2026 created.
+ */
+
+#include <random>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size);
+
+#define MAX_INPUT (64 * 1024)
+
+
+static void runFile(FILE *f)
+{
+  std::vector<uint8_t> data(MAX_INPUT);
+  size_t len = fread(data.data(), 1, data.size(), f);
+  LLVMFuzzerTestOneInput(data.data(), len);
+} // runFile()
+
+
+int main(int argc, char *argv[])
+{
+  unsigned long runs = 0;
+  unsigned long seed = 1;
+  int files = 0;
+
+  for (int n = 1; n < argc; n++) {
+    if ((strcmp(argv[n], "-r") == 0) && (n + 1 < argc)) {
+      runs = strtoul(argv[++n], nullptr, 0);
+    } else if ((strcmp(argv[n], "-s") == 0) && (n + 1 < argc)) {
+      seed = strtoul(argv[++n], nullptr, 0);
+    } else {
+      FILE *f = fopen(argv[n], "rb");
+      if (!f) {
+        fprintf(stderr, "cannot open '%s'\n", argv[n]);
+        return (1);
+      }
+      runFile(f);
+      fclose(f);
+      files++;
+    }
+  } // for
+
+  if (runs) {
+    // random inputs of random length, biased to short inputs.
+    std::mt19937 rnd(seed);
+    std::vector<uint8_t> data(4096);
+    for (unsigned long r = 0; r < runs; r++) {
+      size_t len = rnd() % (1 + (rnd() % data.size()));
+      for (size_t i = 0; i < len; i++)
+        data[i] = (uint8_t)rnd();
+      LLVMFuzzerTestOneInput(data.data(), len);
+    } // for
+    fprintf(stderr, "%lu random runs done.\n", runs);
+
+  } else if (files == 0) {
+    runFile(stdin);
+  }
+  return (0);
+} // main()
+
+// End.
@@ -0,0 +1,72 @@
+/**
+ * @file fuzz_capture.cpp
+ *
+ * This file is part of the RFCodes library that implements receiving an sending
+ * RF and IR protocols.
+ *
+ * @copyright Copyright (c) by Matthias Hertel, https://www.mathertel.de.
+ *
+ * This work is licensed under a BSD 3-Clause style license,
+ * https://www.mathertel.de/License.aspx.
+ *
+ * @brief
+ * Fuzzing harness for the CaptureReader with arbitrary capture files.
+ *
+ * The first 4 bytes are used as the seek index, the remaining bytes are
+ * prefixed by a valid header when they don't start with one to reach the
+ * decoding paths more often.
+ *
+ * Changelog:
+ * * 16.10.2026 created.
+ */
+
+#include <stdint.h>
+#include <string.h>
+#include <vector>
+
+#include "SignalCapture.h"
+
+static std::vector<uint8_t> written;
+
+// sink of the capture writer.
+static void collect(const uint8_t *data, size_t len)
+{
+  written.insert(written.end(), data, data + len);
+} // collect()
+
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size)
+{
+  if (size < 5)
+    return (0);
+
+  uint32_t index = data[0] | (data[1] << 8) | (data[2] << 16) | ((uint32_t)data[3] << 24);
+  data += 4;
+  size -= 4;
+
+  std::vector<uint8_t> capture;
+  if ((size < 4) || (memcmp(data, "RFCP", 4) != 0)) {
+    // use a valid header with a small sync interval.
+    CaptureHeader header;
+    CaptureWriter writer;
+    header.syncInterval = 4;
+    written.clear();
+    writer.begin(header, collect);
+    writer.flush();
+    capture = written;
+  }
+  capture.insert(capture.end(), data, data + size);
+
+  CaptureReader reader;
+  SignalParser::CodeTime buffer[16];
+  if (reader.begin(capture.data(), capture.size())) {
+    while (reader.read(buffer, 16) > 0) {
+    }
+    reader.seek(index % 100000);
+    while (reader.read(buffer, 16) > 0) {
+    }
+  }
+  return (0);
+} // LLVMFuzzerTestOneInput()
+
+// End.
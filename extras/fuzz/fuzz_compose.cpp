@@ -0,0 +1,92 @@
+/**
+ * @file fuzz_compose.cpp
+ *
+ * This file is part of the RFCodes library that implements receiving an sending
+ * RF and IR protocols.
+ *
+ * @copyright Copyright (c) by Matthias Hertel, https://www.mathertel.de.
+ *
+ * This work is licensed under a BSD 3-Clause style license,
+ * https://www.mathertel.de/License.aspx.
+ *
+ * @brief
+ * Fuzzing harness for SignalParser::compose() and SignalCollector::send() with
+ * arbitrary send strings.
+ *
+ * The first byte selects the size of the timings buffer. When the second byte
+ * is below 0x80 the name of a known protocol is used as a prefix to get deeper
+ * into the code. The remaining bytes are the sequence.
+ *
+ * The number of timings must be the same for the size query, the buffer and
+ * the compiled sequence and the buffer must end with a 0 time.
+ *
+ * Changelog:
+ * * 16.10.2026 created.
+ * * 16.10.2026 drive the timer of the non-blocking send().
+ * * 16.10.2026 check the size query and compiled sequences.
+ */
+
+#include <stdint.h>
+#include <string.h>
+#include <string>
+#include <vector>
+
+#include "SignalCollector.h"
+#include "SignalHalSim.h"
+
+#include "ProtocolTable.h"
+
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size)
+{
+  static SignalParser sig;
+  static SignalCollector col;
+  static bool initialized = false;
+
+  if (!initialized) {
+    ProtocolTable::load(&sig, nullptr);
+    col.init(&sig, NO_PIN, 1);
+    initialized = true;
+  }
+
+  if (size < 2)
+    return (0);
+
+  // exact size buffers help the address sanitizer to find overflows.
+  std::vector<SignalParser::CodeTime> timings(data[0]);
+  std::string sequence;
+
+  if (data[1] < 0x80) {
+    int cnt = 0;
+    while (ProtocolTable::all[cnt].name)
+      cnt++;
+    sequence = ProtocolTable::all[data[1] % cnt].name;
+    sequence += ' ';
+  }
+  sequence.append((const char *)data + 2, size - 2);
+
+  int needed = sig.compose(sequence.c_str(), nullptr, 0);
+  int cnt = sig.compose(sequence.c_str(), timings.data(), (int)timings.size());
+  if (cnt != needed)
+    __builtin_trap();
+  if ((cnt >= 0) && (cnt < (int)timings.size()) && (timings[cnt] != 0))
+    __builtin_trap();
+
+  SignalParser::Handle handle;
+  int codes = sig.compile(sequence.c_str(), &handle);
+  if ((codes >= 0) && (SignalParser::compose(&handle, nullptr, 0) != needed))
+    __builtin_trap();
+
+  sig.getSendRepeat(sequence.c_str());
+  if (col.send(sequence.c_str())) {
+    while (col.isSending()) {
+      while (SignalHalSim::runTimer()) {
+        // the edges are written by the timer.
+      }
+      col.loop();
+    }
+  }
+  return (0);
+} // LLVMFuzzerTestOneInput()
+
+// End.
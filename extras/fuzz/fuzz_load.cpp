@@ -0,0 +1,79 @@
+/**
+ * @file fuzz_load.cpp
+ *
+ * This file is part of the RFCodes library that implements receiving an sending
+ * RF and IR protocols.
+ *
+ * @copyright Copyright (c) by Matthias Hertel, https://www.mathertel.de.
+ *
+ * This work is licensed under a BSD 3-Clause style license,
+ * https://www.mathertel.de/License.aspx.
+ *
+ * @brief
+ * Fuzzing harness for SignalParser::load() with arbitrary protocol tables.
+ *
+ * The input is copied into a Protocol structure that is loaded. The remaining
+ * bytes are used as durations for parse() and as a sequence for compose().
+ *
+ * Changelog:
+ * * 16.10.2026 created.
+ * * 16.10.2026 no function pointers from the input, manchester flags.
+ */
+
+#include <stdint.h>
+#include <string.h>
+
+#include "SignalParser.h"
+
+static void receiveCode(const char *code)
+{
+  volatile size_t len = strlen(code);
+  (void)len;
+} // receiveCode()
+
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size)
+{
+  SignalParser::Protocol p;
+  memset(&p, 0, sizeof(p));
+
+  size_t len = (size < sizeof(p)) ? size : sizeof(p);
+  memcpy(&p, data, len);
+  data += len;
+  size -= len;
+
+  // the code types are enums and must use defined bits.
+  for (int n = 0; n < MAX_CODELENGTH; n++) {
+    unsigned char type;
+    memcpy(&type, &p.codes[n].type, 1);
+    p.codes[n].type = (SignalParser::CodeType)(type & (SignalParser::CodeType::START | SignalParser::CodeType::ANY));
+  }
+
+  // no function pointers from the data.
+  p.validate = nullptr;
+  p.manchester &= (SignalParser::MANCHESTER | SignalParser::MANCHESTER_INVERT | SignalParser::MANCHESTER_MID);
+
+  SignalParser sig;
+  sig.load(&p);
+  sig.attachCallback(receiveCode);
+
+  for (size_t i = 0; i + 1 < size; i += 2) {
+    sig.parse(data[i] | (data[i + 1] << 8));
+  }
+
+  // compose a sequence using the name of the protocol and the data as codes.
+  char sequence[PROTNAME_LEN + 1 + 256];
+  size_t nameLen = strlen(p.name);
+  memcpy(sequence, p.name, nameLen);
+  sequence[nameLen] = ' ';
+  size_t codeLen = (size < 256) ? size : 256;
+  memcpy(sequence + nameLen + 1, data, codeLen);
+  sequence[nameLen + 1 + codeLen] = NUL;
+
+  SignalParser::CodeTime timings[64];
+  sig.compose(sequence, timings, 64);
+  sig.getSendRepeat(p.name);
+  return (0);
+} // LLVMFuzzerTestOneInput()
+
+// End.
@@ -0,0 +1,59 @@
+/**
+ * @file fuzz_parse.cpp
+ *
+ * This file is part of the RFCodes library that implements receiving an sending
+ * RF and IR protocols.
+ *
+ * @copyright Copyright (c) by Matthias Hertel, https://www.mathertel.de.
+ *
+ * This work is licensed under a BSD 3-Clause style license,
+ * https://www.mathertel.de/License.aspx.
+ *
+ * @brief
+ * Fuzzing harness for SignalParser::parse() with arbitrary duration streams.
+ *
+ * The first byte selects the loaded protocols, the following bytes are used
+ * as 16 bit little endian durations.
+ *
+ * Changelog:
+ * * 16.10.2026 created.
+ */
+
+#include <stdint.h>
+#include <string.h>
+
+#include "ProtocolTable.h"
+
+static void receiveCode(const char *code)
+{
+  // touch the complete string
+  volatile size_t len = strlen(code);
+  (void)len;
+} // receiveCode()
+
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size)
+{
+  if (size < 1)
+    return (0);
+
+  SignalParser::Protocol protocols[8];
+  SignalParser sig;
+  int cnt = 0;
+
+  for (int n = 0; ProtocolTable::all[n].name && (cnt < 8); n++) {
+    if (data[0] & (1 << n)) {
+      protocols[cnt] = *ProtocolTable::all[n].protocol;
+      sig.load(&protocols[cnt]);
+      cnt++;
+    }
+  } // for
+  sig.attachCallback(receiveCode);
+
+  for (size_t i = 1; i + 1 < size; i += 2) {
+    sig.parse(data[i] | (data[i + 1] << 8));
+  }
+  return (0);
+} // LLVMFuzzerTestOneInput()
+
+// End.
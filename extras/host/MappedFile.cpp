@@ -0,0 +1,127 @@
+/**
+ * @file MappedFile.cpp
+ *
+ * This file is part of the RFCodes library that implements receiving an sending
+ * RF and IR protocols.
+ *
+ * @copyright Copyright (c) by Matthias Hertel, https://www.mathertel.de.
+ *
+ * This work is licensed under a BSD 3-Clause style license,
+ * https://www.mathertel.de/License.aspx.
+ *
+ * @brief
+ * Read only access to input files for the host tools using a memory mapping.
+ *
+ * Change History see MappedFile.h
+ */
+
+#include "MappedFile.h"
+
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+
+// read all data from a file descriptor into memory.
+// returns nullptr when reading failed or no memory is available.
+static char *_readAll(int fd, size_t *len)
+{
+  size_t alloc = 64 * 1024;
+  char *data = (char *)malloc(alloc);
+  *len = 0;
+
+  while (data) {
+    ssize_t n = read(fd, data + *len, alloc - *len);
+    if (n == 0)
+      break;
+    if (n < 0) {
+      free(data);
+      data = nullptr;
+      break;
+    }
+    *len += n;
+    if (*len == alloc) {
+      alloc *= 2;
+      char *p = (char *)realloc(data, alloc);
+      if (!p)
+        free(data);
+      data = p;
+    }
+  } // while
+
+  if (!data)
+    *len = 0;
+  return (data);
+} // _readAll()
+
+
+MappedFile::~MappedFile()
+{
+  close();
+} // ~MappedFile()
+
+
+bool MappedFile::open(const char *name)
+{
+  close();
+
+  bool useStdin = (strcmp(name, "-") == 0);
+  int fd = useStdin ? STDIN_FILENO : ::open(name, O_RDONLY);
+  if (fd < 0)
+    return (false);
+
+  struct stat st;
+  if ((fstat(fd, &st) == 0) && S_ISREG(st.st_mode) && (st.st_size > 0)) {
+    void *p = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (p != MAP_FAILED) {
+      madvise(p, st.st_size, MADV_SEQUENTIAL);
+      _data = (char *)p;
+      _size = st.st_size;
+      _mapped = true;
+    }
+  }
+
+  if (!_mapped) {
+    // pipes, empty files or no mapping possible.
+    _data = _readAll(fd, &_size);
+  }
+
+  if (!useStdin)
+    ::close(fd);
+  return (_data != nullptr);
+} // open()
+
+
+void MappedFile::close()
+{
+  if (_mapped) {
+    munmap(_data, _size);
+  } else {
+    free(_data);
+  }
+  _data = nullptr;
+  _size = 0;
+  _mapped = false;
+  _released = 0;
+} // close()
+
+
+void MappedFile::release(size_t pos)
+{
+  if (_mapped) {
+    size_t pageSize = (size_t)sysconf(_SC_PAGESIZE);
+    size_t end = (pos < _size ? pos : _size) / pageSize * pageSize;
+
+    // release in larger steps to save system calls.
+    if (end >= _released + 64 * pageSize) {
+      madvise(_data + _released, end - _released, MADV_DONTNEED);
+      _released = end;
+    }
+  } // if
+} // release()
+
+// End.
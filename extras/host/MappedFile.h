@@ -0,0 +1,73 @@
+/**
+ * @file: MappedFile.h
+ *
+ * This file is part of the RFCodes library that implements receiving an sending
+ * RF and IR protocols.
+ *
+ * @copyright Copyright (c) by Matthias Hertel, https://www.mathertel.de.
+ *
+ * This work is licensed under a BSD 3-Clause style license,
+ * https://www.mathertel.de/License.aspx.
+ *
+ * @brief
+ * Read only access to input files for the host tools using a memory mapping.
+ *
+ * Regular files are mapped into memory without copying them. The pages that
+ * are already processed can be released so the memory usage stays constant
+ * when streaming through captures of any size. Standard input and other
+ * files that cannot be mapped are read into memory.
+ *
+ * Changelog:
+ * * 16.10.2026 created.
+ * * 16.10.2026 read errors and failed allocations fail open().
+ */
+
+#ifndef MappedFile_H_
+#define MappedFile_H_
+
+#include <stddef.h>
+
+class MappedFile
+{
+public:
+  MappedFile() = default;
+  MappedFile(const MappedFile &) = delete;
+  MappedFile &operator=(const MappedFile &) = delete;
+  ~MappedFile();
+
+  /** open a file for reading.
+   * @param name file name or "-" for stdin.
+   * @return true when the file could be opened.
+   */
+  bool open(const char *name);
+
+  /** close the file and free all resources. */
+  void close();
+
+  /** the content of the file. */
+  const char *data()
+  {
+    return (_data);
+  };
+
+  /** the size of the file in bytes. */
+  size_t size()
+  {
+    return (_size);
+  };
+
+  /** release the memory of the content before the position that is not used any more.
+   * The content before the position must not be accessed afterwards.
+   */
+  void release(size_t pos);
+
+private:
+  char *_data = nullptr;
+  size_t _size = 0;
+  bool _mapped = false;
+  size_t _released = 0;
+}; // class MappedFile
+
+#endif // MappedFile_H_
+
+// End.
@@ -0,0 +1,262 @@
+/**
+ * @file ParallelDecoder.cpp
+ *
+ * This file is part of the RFCodes library that implements receiving an sending
+ * RF and IR protocols.
+ *
+ * @copyright Copyright (c) by Matthias Hertel, https://www.mathertel.de.
+ *
+ * This work is licensed under a BSD 3-Clause style license,
+ * https://www.mathertel.de/License.aspx.
+ *
+ * @brief
+ * Decode large timing streams on multiple threads.
+ *
+ * Change History see ParallelDecoder.h
+ */
+
+#include "ParallelDecoder.h"
+
+#include <string.h>
+#include <utility>
+
+// the chunk and parser of the current thread used by the callback.
+static thread_local std::vector<ParallelDecoder::Frame> *_tlsFrames = nullptr;
+static thread_local size_t _tlsStart = 0;
+static thread_local SignalParser *_tlsSig = nullptr;
+
+
+static void _receiveCode(const char *code)
+{
+  _tlsFrames->push_back({_tlsStart + _tlsSig->getBatchIndex(), code});
+} // _receiveCode()
+
+
+ParallelDecoder::ParallelDecoder(int threads)
+{
+  if (threads <= 0)
+    threads = (int)std::thread::hardware_concurrency();
+  if (threads <= 0)
+    threads = 1;
+
+  for (int n = 0; n < threads; n++) {
+    _workers.push_back(new Worker());
+  }
+} // ParallelDecoder()
+
+
+ParallelDecoder::~ParallelDecoder()
+{
+  {
+    std::lock_guard<std::mutex> guard(_lock);
+    _stop = true;
+  }
+  _wake.notify_all();
+
+  // other workers may still look into the queues until all are stopped.
+  for (Worker *w : _workers) {
+    if (w->thread.joinable())
+      w->thread.join();
+  }
+  for (Worker *w : _workers) {
+    delete w;
+  }
+} // ~ParallelDecoder()
+
+
+void ParallelDecoder::load(const SignalParser::Protocol *protocol)
+{
+  if (protocol && !_started)
+    _protocols.push_back(protocol);
+} // load()
+
+
+void ParallelDecoder::setGap(SignalParser::CodeTime gap)
+{
+  _gap = gap;
+} // setGap()
+
+
+void ParallelDecoder::setChunkSize(size_t size)
+{
+  _chunkSize = size ? size : 1;
+} // setChunkSize()
+
+
+SignalParser::CodeTime ParallelDecoder::gap()
+{
+  SignalParser::CodeTime gap = _gap;
+
+  // calculate the limits like the parser and the segmenter do, including
+  // the half bit times of manchester protocols.
+  std::vector<SignalParser::Protocol> copies(_protocols.size());
+  SignalParser sig;
+  for (size_t n = 0; n < _protocols.size(); n++) {
+    copies[n] = *_protocols[n];
+    sig.load(&copies[n]);
+  }
+
+  SignalParser::CodeTime maxTime;
+  sig.getLimits(nullptr, &maxTime, nullptr);
+  if ((maxTime >= gap) && (maxTime < (SignalParser::CodeTime)~0))
+    gap = maxTime + 1;
+  return (gap);
+} // gap()
+
+
+bool ParallelDecoder::getStatistics(const char *name, SignalParser::Statistics *stats)
+{
+  bool found = false;
+  memset(stats, 0, sizeof(SignalParser::Statistics));
+
+  for (Worker *w : _workers) {
+    SignalParser::Statistics st;
+    if (w->sig.getStatistics(name, &st)) {
+      stats->durations += st.durations;
+      stats->starts += st.starts;
+      stats->symbols += st.symbols;
+      stats->notStart += st.notStart;
+      stats->outOfWindow += st.outOfWindow;
+      stats->fragments += st.fragments;
+      stats->frames += st.frames;
+      stats->rejected += st.rejected;
+      stats->retries += st.retries;
+      found = true;
+    }
+  } // for
+  return (found);
+} // getStatistics()
+
+
+size_t ParallelDecoder::decode(const SignalParser::CodeTime *durations, size_t count, bool last, std::vector<Frame> &frames)
+{
+  if (!_started)
+    _start();
+
+  // split the part into chunks after gaps.
+  SignalParser::CodeTime splitGap = gap();
+  std::vector<Chunk> chunks;
+  size_t start = 0;
+
+  for (size_t i = 0; i < count; i++) {
+    if ((durations[i] >= splitGap) && (i + 1 - start >= _chunkSize)) {
+      chunks.push_back({durations + start, start, i + 1 - start, {}});
+      start = i + 1;
+    }
+  } // for
+
+  if (last && (start < count)) {
+    chunks.push_back({durations + start, start, count - start, {}});
+    start = count;
+  }
+
+  if (chunks.empty())
+    return (0);
+
+  // pass blocks of chunks to the workers.
+  {
+    std::lock_guard<std::mutex> guard(_lock);
+    size_t workers = _workers.size();
+    size_t n = 0;
+    for (size_t w = 0; w < workers; w++) {
+      size_t end = chunks.size() * (w + 1) / workers;
+      std::lock_guard<std::mutex> queueGuard(_workers[w]->lock);
+      while (n < end) {
+        _workers[w]->queue.push_back(&chunks[n++]);
+      }
+    }
+    _pending = chunks.size();
+    _generation++;
+  }
+  _wake.notify_all();
+
+  {
+    std::unique_lock<std::mutex> guard(_lock);
+    _done.wait(guard, [this] { return (_pending == 0); });
+  }
+
+  // merge the frames in stream order.
+  for (Chunk &c : chunks) {
+    for (Frame &f : c.frames) {
+      frames.push_back({_base + f.index, std::move(f.code)});
+    }
+  }
+
+  _base += start;
+  return (start);
+} // decode()
+
+
+void ParallelDecoder::_start()
+{
+  _started = true;
+
+  for (Worker *w : _workers) {
+    // own copies of the protocols as they hold the parsing state.
+    w->protocols.reserve(_protocols.size());
+    for (const SignalParser::Protocol *p : _protocols) {
+      w->protocols.push_back(*p);
+      w->sig.load(&w->protocols.back());
+    }
+    w->sig.attachCallback(_receiveCode);
+    w->thread = std::thread(&ParallelDecoder::_run, this, w);
+  }
+} // _start()
+
+
+void ParallelDecoder::_run(Worker *w)
+{
+  unsigned long generation = 0;
+  _tlsSig = &w->sig;
+
+  while (true) {
+    {
+      std::unique_lock<std::mutex> guard(_lock);
+      _wake.wait(guard, [&] { return (_stop || (_generation != generation)); });
+      if (_stop)
+        break;
+      generation = _generation;
+    }
+
+    Chunk *c;
+    while ((c = _next(w)) != nullptr) {
+      // a chunk starts after a gap where all protocols are reset.
+      w->sig.reset();
+      _tlsFrames = &c->frames;
+      _tlsStart = c->start;
+      w->sig.parse(c->durations, (int)c->count);
+
+      std::lock_guard<std::mutex> guard(_lock);
+      if (--_pending == 0)
+        _done.notify_one();
+    }
+  } // while
+} // _run()
+
+
+// take the next chunk from the own queue or steal one from the end of another queue.
+ParallelDecoder::Chunk *ParallelDecoder::_next(Worker *w)
+{
+  {
+    std::lock_guard<std::mutex> guard(w->lock);
+    if (!w->queue.empty()) {
+      Chunk *c = w->queue.front();
+      w->queue.pop_front();
+      return (c);
+    }
+  }
+
+  for (Worker *other : _workers) {
+    if (other != w) {
+      std::lock_guard<std::mutex> guard(other->lock);
+      if (!other->queue.empty()) {
+        Chunk *c = other->queue.back();
+        other->queue.pop_back();
+        return (c);
+      }
+    }
+  } // for
+  return (nullptr);
+} // _next()
+
+// End.
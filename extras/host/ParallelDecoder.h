@@ -0,0 +1,140 @@
+/**
+ * @file: ParallelDecoder.h
+ *
+ * This file is part of the RFCodes library that implements receiving an sending
+ * RF and IR protocols.
+ *
+ * @copyright Copyright (c) by Matthias Hertel, https://www.mathertel.de.
+ *
+ * This work is licensed under a BSD 3-Clause style license,
+ * https://www.mathertel.de/License.aspx.
+ *
+ * @brief
+ * Decode large timing streams on multiple threads.
+ *
+ * A duration that is longer than all timings of the loaded protocols cannot
+ * be part of any code, so every protocol is reset by it. The stream is split
+ * after such gaps into chunks that are decoded independently with the same
+ * result as decoding the whole stream with a single SignalParser.
+ *
+ * The chunks are decoded on a pool of worker threads. Every worker has its
+ * own SignalParser with copies of the protocol definitions as the Protocol
+ * structures also hold the parsing state. The chunks are distributed to the
+ * workers in blocks, a worker without chunks steals from the end of the
+ * block of another worker. The found frames are merged in stream order.
+ *
+ * Changelog:
+ * * 16.10.2026 created.
+ * * 16.10.2026 gap above the manchester half bit times.
+ */
+
+#ifndef ParallelDecoder_H_
+#define ParallelDecoder_H_
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "SignalParser.h"
+
+class ParallelDecoder
+{
+public:
+  // A decoded frame.
+  struct Frame {
+    unsigned long long index; // index of the duration that completed the frame in the stream.
+    std::string code;         // "<protocol> <codes>"
+  };
+
+  /** create the decoder.
+   * @param threads number of worker threads, 0 for the number of cores.
+   */
+  explicit ParallelDecoder(int threads = 0);
+  ParallelDecoder(const ParallelDecoder &) = delete;
+  ParallelDecoder &operator=(const ParallelDecoder &) = delete;
+  ~ParallelDecoder();
+
+  /** add a protocol definition. All protocols must be added before decoding. */
+  void load(const SignalParser::Protocol *protocol);
+
+  /** set the minimal duration in µsecs where the stream is split, default: 20000.
+   * The gap is always longer than the longest timing of the loaded protocols.
+   */
+  void setGap(SignalParser::CodeTime gap);
+
+  /** set the minimal number of durations in a chunk, default: 16384. */
+  void setChunkSize(size_t size);
+
+  /** the duration where the stream is split. */
+  SignalParser::CodeTime gap();
+
+  /** number of worker threads. */
+  int threads()
+  {
+    return ((int)_workers.size());
+  };
+
+  /** start decoding a new stream with index 0. */
+  void reset()
+  {
+    _base = 0;
+  };
+
+  /** get the statistics counters of a protocol summed up over all workers.
+   * @return true when the protocol is loaded.
+   */
+  bool getStatistics(const char *name, SignalParser::Statistics *stats);
+
+  /** decode the next part of the stream.
+   * Only the durations up to the last gap are decoded unless this is the last part.
+   * The remaining durations must be passed again at the start of the next part.
+   * @param durations the durations.
+   * @param count number of durations.
+   * @param last true for the last part of the stream.
+   * @param frames the found frames are appended in stream order.
+   * @return number of decoded durations.
+   */
+  size_t decode(const SignalParser::CodeTime *durations, size_t count, bool last, std::vector<Frame> &frames);
+
+private:
+  struct Chunk {
+    const SignalParser::CodeTime *durations;
+    size_t start; // index of the first duration in the part.
+    size_t count;
+    std::vector<Frame> frames;
+  };
+
+  struct Worker {
+    std::thread thread;
+    std::mutex lock;
+    std::deque<Chunk *> queue;
+    std::vector<SignalParser::Protocol> protocols;
+    SignalParser sig;
+  };
+
+  std::vector<const SignalParser::Protocol *> _protocols;
+  std::vector<Worker *> _workers;
+  SignalParser::CodeTime _gap = 20000;
+  size_t _chunkSize = 16384;
+  unsigned long long _base = 0; // index of the first duration of the current part in the stream.
+  bool _started = false;
+
+  // synchronization of the workers
+  std::mutex _lock;
+  std::condition_variable _wake;
+  std::condition_variable _done;
+  unsigned long _generation = 0;
+  size_t _pending = 0;
+  bool _stop = false;
+
+  void _start();
+  void _run(Worker *w);
+  Chunk *_next(Worker *w);
+}; // class ParallelDecoder
+
+#endif // ParallelDecoder_H_
+
+// End.
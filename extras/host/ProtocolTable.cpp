@@ -0,0 +1,109 @@
+/**
+ * @file ProtocolTable.cpp
+ *
+ * This file is part of the RFCodes library that implements receiving an sending
+ * RF and IR protocols.
+ *
+ * @copyright Copyright (c) by Matthias Hertel, https://www.mathertel.de.
+ *
+ * This work is licensed under a BSD 3-Clause style license,
+ * https://www.mathertel.de/License.aspx.
+ *
+ * @brief
+ * Lookup of the protocols from protocols.h and ircodes.h by name for the host tools.
+ *
+ * Change History see ProtocolTable.h
+ */
+
+#include "ProtocolTable.h"
+
+#include <string.h>
+
+#include "ircodes.h"
+#include "protocols.h"
+
+
+const ProtocolTable::Entry ProtocolTable::all[] = {
+    {"it1", &RFCodes::it1},
+    {"it2", &RFCodes::it2},
+    {"sc5", &RFCodes::sc5},
+    {"cw", &RFCodes::cw},
+    {"nec", &IRCodes::nec},
+    {"rc5", &IRCodes::rc5},
+    {nullptr, nullptr}};
+
+
+SignalParser::Protocol *ProtocolTable::find(const char *name)
+{
+  for (const Entry *e = all; e->name; e++) {
+    if (strcmp(name, e->name) == 0)
+      return (e->protocol);
+  }
+  return (nullptr);
+} // find()
+
+
+int ProtocolTable::select(const char *list, SignalParser::Protocol **protocols, int len)
+{
+  int cnt = 0;
+
+  if (!list) {
+    for (const Entry *e = all; e->name && (cnt < len); e++) {
+      protocols[cnt++] = e->protocol;
+    }
+
+  } else {
+    char name[PROTNAME_LEN];
+
+    while (*list) {
+      // extract next name
+      int nameLen = 0;
+      while (*list && (*list != ',')) {
+        if (nameLen < PROTNAME_LEN - 1)
+          name[nameLen++] = *list;
+        list++;
+      }
+      name[nameLen] = NUL;
+      if (*list == ',')
+        list++;
+
+      if (nameLen) {
+        SignalParser::Protocol *p = find(name);
+        if (!p)
+          return (-1);
+        if (cnt < len)
+          protocols[cnt++] = p;
+      }
+    } // while
+  }
+  return (cnt);
+} // select()
+
+
+int ProtocolTable::load(SignalParser *sig, const char *list)
+{
+  SignalParser::Protocol *protocols[32];
+  int cnt = select(list, protocols, 32);
+
+  for (int n = 0; n < cnt; n++) {
+    sig->load(protocols[n]);
+  }
+  return (cnt);
+} // load()
+
+
+int ProtocolTable::timingCount(SignalParser::Protocol *p, const char *seq)
+{
+  SignalParser::Handle handle;
+
+  // the encoder joins the half bits of manchester protocols.
+  SignalParser::begin(&handle, p);
+  while (*seq) {
+    if (!SignalParser::append(&handle, *seq++))
+      return (0);
+  }
+  int cnt = SignalParser::compose(&handle, nullptr, 0);
+  return ((cnt < 0) ? 0 : cnt);
+} // timingCount()
+
+// End.
@@ -0,0 +1,69 @@
+/**
+ * @file: ProtocolTable.h
+ *
+ * This file is part of the RFCodes library that implements receiving an sending
+ * RF and IR protocols.
+ *
+ * @copyright Copyright (c) by Matthias Hertel, https://www.mathertel.de.
+ *
+ * This work is licensed under a BSD 3-Clause style license,
+ * https://www.mathertel.de/License.aspx.
+ *
+ * @brief
+ * Lookup of the protocols from protocols.h and ircodes.h by name for the host tools.
+ *
+ * Changelog:
+ * * 16.10.2026 created.
+ * * 16.10.2026 rc5.
+ * * 16.10.2026 timingCount() of manchester protocols.
+ */
+
+#ifndef ProtocolTable_H_
+#define ProtocolTable_H_
+
+#include "SignalParser.h"
+
+/** namespace for the known protocol definitions. */
+namespace ProtocolTable
+{
+
+struct Entry {
+  const char *name;
+  SignalParser::Protocol *protocol;
+};
+
+/** all known protocols, terminated by an entry with a null name. */
+extern const Entry all[];
+
+/** find a protocol by name.
+ * @return the protocol or nullptr when not known.
+ */
+SignalParser::Protocol *find(const char *name);
+
+/** find protocols by a list of names.
+ * @param list comma separated list of protocol names like "it1,it2" or nullptr for all protocols.
+ * @param protocols the found protocols are stored here.
+ * @param len size of the protocols array.
+ * @return number of found protocols or -1 when a name is not known.
+ */
+int select(const char *list, SignalParser::Protocol **protocols, int len);
+
+/** load protocols into the parser.
+ * @param sig the parser.
+ * @param list comma separated list of protocol names like "it1,it2" or nullptr for all protocols.
+ * @return number of loaded protocols or -1 when a name is not known.
+ */
+int load(SignalParser *sig, const char *list);
+
+/** number of durations of a sequence like they are composed for sending.
+ * @param p the protocol.
+ * @param seq the code characters without the protocol name.
+ * @return the number of durations or 0 when a code is not defined.
+ */
+int timingCount(SignalParser::Protocol *p, const char *seq);
+
+} // namespace ProtocolTable
+
+#endif // ProtocolTable_H_
+
+// End.
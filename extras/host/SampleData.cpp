@@ -0,0 +1,129 @@
+/**
+ * @file SampleData.cpp
+ *
+ * This file is part of the RFCodes library that implements receiving an sending
+ * RF and IR protocols.
+ *
+ * @copyright Copyright (c) by Matthias Hertel, https://www.mathertel.de.
+ *
+ * This work is licensed under a BSD 3-Clause style license,
+ * https://www.mathertel.de/License.aspx.
+ *
+ * @brief
+ * Recorded timings used by the host benchmarks and tests.
+ *
+ * Change History see SampleData.h
+ */
+
+#include "SampleData.h"
+
+// The test data from examples/testcodes/testcodes.ino with the expected results.
+const SignalParser::CodeTime SampleData::testcodes[] = {
+    /* noise */ 13462, 70, 1433, 171, 232, 98, 1239, 337, 318, 52, 469, 182, 340, 432, 2860, 269, 4056, 108, 3290, 79, 2904, 260, 2870, 158, 7818, 75, 2047, 183, 520, 152, 161, 115, 114, 329, 340, 95, 4309, 153, 5210, 28, 2966, 273, 4856, 75, 955, 289, 333, 254, 433, 65, 129, 261, 609,
+
+    520, 328, 1380, 1209, 513, 346, 1386, 1168, 534, 346, 1365, 1213, 507, 339, 1375, 346, 1372, 359, 13353, 392, 1317, 262, 48, 128, 95, 722, 466, 375, 1337, 1242, 492, 375, 1334, 388, 1350, 363, 1331, 1244, 478, 383, 1329, 389, 1329, 388, 1325, 1249, 477, 382, 1364, 1213, 522, 338, 1338, 1237, 496, 361, 1341, 1233, 493, 369, 1331, 1252, 465, 388, 1331, 1244, 469, 392, 1327, 390, 1322,
+
+    // submitting it1 3 times:
+    397, 13320,
+    427, 1288, 1280, 446, 410, 1306, 1269, 451, 403, 1313, 409, 1308, 407, 1308, 1270, 452, 406, 1306, 412, 1309, 409, 1303, 1273, 446, 411, 1308, 1278, 442, 405, 1308, 1263, 456, 409, 1308, 1272, 448, 409, 1306, 1268, 464, 397, 1309, 1271, 448, 404, 1311, 407, 1310,
+    // find: [it1 B001010000001]
+    397, 13320,
+    // find: [sc5 ff0f0ffffff0S]
+    427, 1288, 1280, 446, 410, 1306, 1269, 451, 403, 1313, 409, 1308, 407, 1308, 1270, 452, 406, 1306, 412, 1309, 409, 1303, 1273, 446, 411, 1308, 1278, 442, 405, 1308, 1263, 456, 409, 1308, 1272, 448, 409, 1306, 1268, 464, 397, 1309, 1271, 448, 404, 1311, 407, 1310,
+    // find: [it1 B001010000001]
+    408, 13334,
+    // find: [sc5 ff0f0ffffff0S]
+    427, 1288, 1280, 446, 410, 1306, 1269, 451, 403, 1313, 409, 1308, 407, 1308, 1270, 452, 406, 1306, 412, 1309, 409, 1303, 1273, 446, 411, 1308, 1278, 442, 405, 1308, 1263, 456, 409, 1308, 1272, 448, 409, 1306, 1268, 464, 397, 1309, 1271, 448, 404, 1311, 407, 1310,
+    // find: [it1 B001010000001]
+
+    /* noise */ 445, 80, 1296, 128,
+
+    443, 13281,
+    460, 1257, 1313, 403, 464, 1254, 1310, 412, 450, 1263, 1311, 410, 449, 1265, 449, 1269, 452, 1265, 454, 1265, 446, 1267, 1312, 408, 452, 1264, 1310, 409, 451, 1265, 1311, 410, 448, 1267, 1305, 417, 443, 1271, 1306, 411, 445, 1274, 1308, 410, 443, 1276, 442, 1271,
+    // find: [it1 B000110000001]
+
+    /* noise */ 70, 232,
+
+    // ideal, valid sc5: [sc5 0001100000011S]
+    350, 1080, 350, 1080, 350, 1080, 350, 1080, 350, 1080, 350, 1080, 1080, 350, 1080, 350,
+    350, 1080, 350, 1080, 350, 1080, 350, 1080, 350, 1080, 350, 1080, 350, 1080, 350, 1080,
+    350, 1080, 350, 1080, 350, 1080, 350, 1080, 350, 1080, 350, 1080, 1080, 350, 1080, 350,
+    350, 10912,
+    // find: [
+
+    /* noise */ 70, 1433, 171, 232, 98, 1239, 337, 318, 52, 955, 289, 333, 254, 433, 65,
+
+    327, 2760, 326, 246, 324, 1316, 332, 1312, 320, 249, 332, 1307, 323, 257, 328, 237, 329, 1318, 327, 239, 323, 1324, 323, 1309, 336, 246, 327, 1304, 336, 256, 313, 243, 327, 1331, 324, 246, 323, 1322, 322, 1314, 324, 254, 326, 242, 324, 1317, 330, 245, 323, 1323,
+    322, 1308, 325, 252, 323, 1315, 324, 258, 316, 1316, 328, 253, 320, 1313, 325, 262, 326, 244, 329, 1316, 325, 242, 330, 1322, 322, 240, 325, 1320, 326, 244, 325, 1328, 316, 1311, 330, 247, 326, 1310, 324, 257, 319, 251, 321, 1326, 318, 254, 315, 1340, 319, 1312,
+    319, 265, 320, 243, 320, 1321, 325, 246, 323, 1321, 325, 247, 317, 1329, 314, 254, 321, 1320, 324, 249, 316, 1329, 318, 249, 319, 1328, 320, 249, 314, 1318, 321, 8387,
+    // find: [it2 s_##__##__#__####____##__#_______x]
+
+    /* noise */ 70, 1433, 171, 232, 98, 1239, 337, 318, 52, 955, 289, 333, 254, 433, 65,
+
+    305,
+    327, 2760, 326, 246, 324, 1316, 332, 1312, 320, 249, 332, 1307, 323, 257, 328, 237, 329, 1318, 327, 239, 323, 1324, 323, 1309, 336, 246, 327, 1304, 336, 256, 313, 243, 327, 1331, 324, 246, 323, 1322, 322, 1314, 324, 254, 326, 242, 324, 1317, 330, 245, 323, 1323,
+    322, 1308, 325, 252, 323, 1315, 324, 258, 316, 1316, 328, 253, 320, 1313, 325, 262, 326, 244, 329, 1316, 325, 242, 330, 1322, 322, 240, 325, 1320, 326, 244, 325, 1328, 316, 1311, 330, 247, 326, 1310, 324, 257, 319, 251, 321, 1326, 318, 254, 315, 1340, 319, 1312,
+    319, 265, 320, 243, 320, 1321, 325, 246, 323, 1321, 325, 247, 317, 1329, 314, 254, 321, 1320, 324, 249, 316, 1329, 318, 249, 319, 1328, 314, 1318, 320, 249, 321, 8387,
+    // find: [it2 s_##__##__#__####____##__#______#x]
+
+    /* noise */ 589, 396, 595, 377, 1077, 878, 1086, 375, 55568,
+
+    1044, 918, 1021, 940, 1003,
+    462, 509, 470, 492, 980, 486, 487, 972, 987, 477, 506, 456, 525, 945, 1007, 456, 533, 436, 533, 440, 535, 448, 531, 925, 1023, 935, 539, 438, 531, 440, 1028, 931, 1014, 447, 535, 930, 1028, 924, 1027, 437, 548, 441, 526, 924, 1038, 431, 536, 439, 535, 447, 538,
+    926, 1019, 941, 1016, 439, 537, 445, 533, 927, 530, 446, 536, 438, 536, 443, 533, 451, 535, 440, 1015, 934, 1020, 930, 537, 443, 1028, 436, 530, 450, 532, 442, 535, 437, 537, 450, 530, 444, 535,
+    // find: [cw H1100100010000010111010010100010000101000111111010110000000]
+
+    /* noise */ 941, 1016, 439, 537,
+
+    0};
+
+const char *SampleData::testresults[] = {
+    "it1 B001010000001",
+    "sc5 ff0f0ffffff0S",
+    "it1 B001010000001",
+    "sc5 ff0f0ffffff0S",
+    "it1 B001010000001",
+    "it1 B000110000001",
+    "sc5 000100000001S",
+    "it2 s_##__##__#__####____##__#_______x",
+    "it2 s_##__##__#__####____##__#______#x",
+    "cw H1100100010000010111010010100010000101000111111010110000000",
+    nullptr};
+
+// The recording from docs/scanner.md, before and after the starting condition.
+const SignalParser::CodeTime SampleData::scanner[] = {
+    139, 9, 33, 3795, 162, 50, 7, 686, 428, 1259, 1321, 427, 415, 439, 26, 794, 1329, 79, 8, 73, 35, 178, 482, 1263, 494, 1262, 432, 1252, 1343, 359, 454, 1312,
+    447, 1264, 395, 1288, 1347, 386, 436, 1254, 1352, 334, 585, 1174, 1343, 441, 367, 1305, 1263, 423, 465, 1250, 1323, 446, 408, 1272, 19, 27, 1257, 425, 409, 1297, 450, 1264,
+    478, 7464, 40, 1419, 37, 60, 40, 4184, 431, 270, 33, 1014, 494, 27, 741, 419, 492, 912, 93, 35, 59, 153, 1327, 382, 431, 460, 30, 787, 445, 1253, 484, 1228,
+    1371, 376, 475, 1247, 439, 1245, 454, 1315, 1271, 431, 395, 1273, 1334, 399, 454, 1268, 594, 24, 700, 407, 482, 1215, 1328, 423, 451, 1274, 1288, 386, 472, 1300, 1255, 415,
+    426, 1285, 476, 1245, 467, 2557, 42, 10668, 484, 1235, 1308, 438, 404, 371, 130, 774, 1340, 380, 427, 971, 10, 326, 415, 1266, 465, 1248, 378, 24, 40, 16, 918, 361,
+    512, 848, 40, 353, 422, 1268, 33, 8, 428, 1224, 1351, 393, 452, 1234, 1324, 458, 413, 1249, 1296, 437, 418, 1294, 1289, 497, 387, 1266, 1143, 551, 441, 1326, 1272, 393,
+    284, 19, 142, 1334, 285, 8, 48, 1381, 396, 10274, 44, 2689, 61, 37, 21, 126, 511, 66, 14, 1142, 1299, 410, 452, 21, 66, 370, 18, 843, 1247, 412, 481, 1296,
+    433, 1264, 463, 1220, 1305, 399, 462, 1259, 469, 1259, 470, 1228, 2390, 8, 845, 247, 1284, 513, 22, 32, 300, 1301, 2104, 658, 1888, 504, 381, 1275, 205, 8, 1057, 477,
+    324, 29, 64, 1299, 1133, 685, 118, 26, 183, 1266, 232, 14, 453, 1009, 206, 28, 104, 46, 95, 13243, 484, 1239, 1315, 401, 446, 1327, 1275, 389, 426, 1276, 462, 1267,
+    461, 1254, 549, 24, 695, 443, 456, 1256, 475, 1246, 445, 1333, 413, 19, 794, 430, 458, 1271, 1302, 393, 359, 23, 88, 1253, 291, 84, 50, 33, 29, 31, 848, 352,
+    196, 30, 226, 1294, 137, 15, 1115, 443, 404, 1292, 235, 38, 1032, 408, 454, 1272, 29, 33, 1273, 447, 134, 8, 204, 1414, 374, 150, 194, 1032, 340, 9552, 41, 3698,
+    395, 1275, 1337, 372, 473, 1274, 1068, 15, 228, 389, 31, 8, 429, 1233, 456, 1269, 249, 30, 199, 1284, 1250, 409, 449, 1273, 485, 1267, 418, 1114, 1463, 8, 29, 99,
+    189, 85, 457, 1302, 1260, 410, 581, 1167, 65, 8, 1209, 413, 449, 1253, 1350, 406, 490, 1234, 1298, 381, 134, 132, 141, 1311, 1338, 377, 430, 1125, 12, 141, 458, 1279,
+    425, 5892, 46, 69, 73, 875, 35, 1854, 60, 60, 39, 2063, 59, 2212, 441, 180, 58, 1009, 1276, 408, 480, 735, 41, 459, 1355, 416, 483, 829, 64, 281, 482, 1235,
+    509, 1242, 1319, 377, 466, 191, 57, 1014, 455, 1245, 299, 9, 182, 1237, 1280, 180, 30, 75, 37, 64, 507, 1294, 56, 8, 246, 11, 1020, 354, 418, 64, 292, 27,
+    517, 205, 89, 84, 1157, 576, 455, 1270, 1327, 368, 473, 1259, 1154, 28, 81, 455, 472, 1230, 1323, 422, 438, 1248, 427, 15, 175, 245, 167, 990, 288, 1231, 130, 7424,
+    266, 4224, 468, 1302, 1244, 102, 773, 1264, 1372, 391, 64, 35, 353, 1341, 57, 12, 207, 1396, 390, 1303, 70, 18, 1075, 14, 107, 394, 471, 1424, 28, 9, 235, 1278,
+    472, 1214, 1322, 301, 519, 1298, 1300, 436, 409, 1188, 515, 12, 899, 432, 351, 1318, 1291, 476, 430, 1286, 1306, 372, 422, 874, 206, 235, 753, 19, 532, 456, 381, 463,
+    96, 838, 291, 402, 20, 908, 437, 7541, 46, 2059, 15, 1561, 58, 1966, 454, 404, 95, 364, 37, 46, 72, 250, 1306, 463, 436, 1046, 50, 18, 58, 84, 1322, 415,
+    451, 847, 28, 346, 455, 807, 37, 438, 64, 91, 251, 1281, 1320, 259, 53, 96, 433, 172, 17, 985, 25, 179, 425, 24, 38, 1140, 501, 200, 47, 1005, 35, 18,
+    1251, 359, 488, 1268, 1321, 31, 30, 51, 44, 224, 445, 972, 51, 288, 677, 8, 557, 420, 537, 1227, 1286, 383, 468, 1267, 1355, 387, 35, 27, 404, 1265, 1283, 376,
+    412, 1303, 487, 1253, 492, 2058, 26, 1920, 62, 1600, 45, 3165, 414, 3710, 54, 175, 473, 1267, 1325, 399, 448, 1212, 1371, 385, 472, 1220, 473, 1239, 489, 1235, 1344, 370,
+    493, 1226, 510, 1298, 403, 108, 33, 1120, 661, 141, 509, 373, 480, 1240, 1344, 384, 437, 1290, 1304, 403, 455, 1238, 1308, 414, 470, 1288, 1280, 443, 433, 1228, 1320, 461,
+    473, 75, 491, 205, 93, 326, 451, 1301, 427, 8101, 25, 5133, 524, 1233, 1289, 433, 438, 1234, 1296, 414, 484, 1273, 470, 1221, 468, 436, 90, 724, 1334, 366, 450, 1317,
+    408, 1283, 482, 1263, 1278, 386, 485, 1276, 1287, 446, 433, 1259, 1303, 410, 477, 1218, 1270, 551, 356, 1362, 1248, 422, 417, 1234, 1346, 383, 466, 1262, 445, 1254, 452, 13296,
+    32, 19, 361, 1290, 1339, 377, 481, 1265, 1284, 411, 67, 19, 384, 1268, 452, 1220, 453, 1266, 1364, 394, 48, 16, 118, 1500, 452, 1317, 475, 1362, 1179, 368, 486, 1248,
+    1313, 376, 493, 1241, 1339, 403, 465, 1205, 1338, 404, 483, 1234, 1311, 503, 343, 1293, 124, 11, 1137, 409, 503, 1300, 359, 1301, 447, 13277, 476, 1241, 1313, 406, 482, 1259,
+    1323, 337, 502, 1241, 464, 1274, 408, 1267, 1364, 367, 442, 1267, 112, 21, 382, 1200, 486, 1270, 1341, 332, 485, 1272, 1306, 414, 444, 1229, 1304, 461, 433, 1252, 65, 13,
+    2391, 30, 835, 182, 63, 10, 892, 712, 379, 1311, 1308, 395, 461, 1333, 393, 473, 116, 683, 424, 4189, 203, 5493, 291, 3150, 365, 1328, 1309, 395, 452, 1301, 1271, 433,
+    437, 1302, 411, 1296, 413, 1308, 1274, 589, 253, 1261, 423, 1341, 18, 39, 374, 1231, 1304, 481, 406, 1286, 22, 29, 1233, 431, 45, 15, 385, 1268, 1072, 27, 205, 480,
+    308, 1312, 1326, 401, 438, 1375, 1192, 468, 438, 1229, 1320, 379, 501, 1224, 477, 1240, 475, 13259, 454, 1286, 1298, 429, 434, 1245, 29, 11, 1337, 457, 381, 1215, 477, 1237,
+    442, 1303, 378, 16, 914, 438, 361, 1311, 455, 1260, 58, 16, 412, 1218, 1368, 367, 487, 1252, 1302, 409, 423, 1261, 1343, 413, 35, 27, 389, 267, 2309, 379, 501, 610,
+    0};
+
+// End.
@@ -0,0 +1,50 @@
+/**
+ * @file: SampleData.h
+ *
+ * This file is part of the RFCodes library that implements receiving an sending
+ * RF and IR protocols.
+ *
+ * @copyright Copyright (c) by Matthias Hertel, https://www.mathertel.de.
+ *
+ * This work is licensed under a BSD 3-Clause style license,
+ * https://www.mathertel.de/License.aspx.
+ *
+ * @brief
+ * Recorded timings used by the host benchmarks and tests.
+ *
+ * Changelog:
+ * * 16.10.2026 created.
+ */
+
+#ifndef SampleData_H_
+#define SampleData_H_
+
+#include "SignalParser.h"
+
+/** namespace for the recorded sample timings. All tables end with a 0 time. */
+namespace SampleData
+{
+
+/** test data from the testcodes.ino example with it1, it2, sc5 and cw frames. */
+extern const SignalParser::CodeTime testcodes[];
+
+/** the expected frames in the testcodes data, terminated by nullptr. */
+extern const char *testresults[];
+
+/** recording of the scanner example from docs/scanner.md. */
+extern const SignalParser::CodeTime scanner[];
+
+/** number of timings in a table ending with a 0 time. */
+inline int count(const SignalParser::CodeTime *table)
+{
+  int cnt = 0;
+  while (table[cnt])
+    cnt++;
+  return (cnt);
+}
+
+} // namespace SampleData
+
+#endif // SampleData_H_
+
+// End.
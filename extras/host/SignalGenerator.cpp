@@ -0,0 +1,282 @@
+/**
+ * @file SignalGenerator.cpp
+ *
+ * This file is part of the RFCodes library that implements receiving an sending
+ * RF and IR protocols.
+ *
+ * @copyright Copyright (c) by Matthias Hertel, https://www.mathertel.de.
+ *
+ * This work is licensed under a BSD 3-Clause style license,
+ * https://www.mathertel.de/License.aspx.
+ *
+ * @brief
+ * Generator for synthetic timing streams with ground truth.
+ *
+ * Change History see SignalGenerator.h
+ */
+
+#include "SignalGenerator.h"
+
+#include <math.h>
+#include <string.h>
+
+#include "SignalDecoder.h"
+#include "ircodes.h"
+#include "protocols.h"
+
+
+SignalGenerator::SignalGenerator(unsigned long seed)
+    : _rnd(seed)
+{
+} // SignalGenerator()
+
+
+void SignalGenerator::clear(unsigned long seed)
+{
+  _rnd.seed(seed);
+  _stream.clear();
+  _frames.clear();
+  _time = 0;
+} // clear()
+
+
+std::string SignalGenerator::randomCodes(const SignalParser::Protocol *p)
+{
+  std::string codes;
+  std::vector<char> startCodes, dataCodes, endCodes;
+
+  // random codes will not pass the validate functions of the library.
+  if (p->validate == SignalDecoder::validateNec)
+    return (_validCodes(p, true));
+  if (p->validate == SignalDecoder::validateCw)
+    return (_validCodes(p, false));
+
+  for (int n = 0; (n < MAX_CODELENGTH) && p->codes[n].name; n++) {
+    const SignalParser::Code *c = &p->codes[n];
+    if ((c->type & SignalParser::CodeType::START) && !(c->type & SignalParser::CodeType::END))
+      startCodes.push_back(c->name);
+    if ((c->type & SignalParser::CodeType::DATA) && !(c->type & SignalParser::CodeType::END))
+      dataCodes.push_back(c->name);
+    if (c->type & SignalParser::CodeType::END)
+      endCodes.push_back(c->name);
+  } // for
+
+  if (p->manchester) {
+    // the bits are not part of the code table.
+    dataCodes.push_back('0');
+    dataCodes.push_back('1');
+  }
+
+  int maxLen = p->maxCodeLen;
+  if (maxLen > MAX_SEQUENCE_LENGTH - 1)
+    maxLen = MAX_SEQUENCE_LENGTH - 1;
+
+  int len = maxLen; // without end code a sequence is complete with the maximal length only.
+  if (!endCodes.empty()) {
+    int minLen = (p->minCodeLen > 2) ? p->minCodeLen : 2;
+    if (minLen > maxLen)
+      minLen = maxLen;
+    len = std::uniform_int_distribution<int>(minLen, maxLen)(_rnd);
+  }
+
+  if (startCodes.empty() || (len < 1) || (dataCodes.empty() && (len > 2)))
+    return (codes);
+
+  auto pick = [this](const std::vector<char> &list) {
+    return (list[std::uniform_int_distribution<size_t>(0, list.size() - 1)(_rnd)]);
+  };
+
+  codes += pick(startCodes);
+
+  if (p->manchester && !(p->manchester & SignalParser::MANCHESTER_MID) && ((int)codes.size() < len)) {
+    // the first half of the first bit must change the level after the start code.
+    int last = 0;
+    for (int n = 0; (n < MAX_CODELENGTH) && p->codes[n].name; n++) {
+      if (p->codes[n].name == codes[0]) {
+        while ((last < MAX_TIMELENGTH) && p->codes[n].time[last])
+          last++;
+      }
+    } // for
+    int bit = (last % 2) ? 0 : 1; // the first timing is high.
+    if (p->manchester & SignalParser::MANCHESTER_INVERT)
+      bit = 1 - bit;
+    codes += (char)('0' + bit);
+  } // if
+
+  while ((int)codes.size() < len - (endCodes.empty() ? 0 : 1))
+    codes += pick(dataCodes);
+  if (!endCodes.empty())
+    codes += pick(endCodes);
+  return (codes);
+} // randomCodes()
+
+
+// build a nec or cw sequence with random values using the encode functions.
+std::string SignalGenerator::_validCodes(const SignalParser::Protocol *p, bool nec)
+{
+  SignalParser::Handle handle;
+  char text[PROTNAME_LEN + MAX_SEQUENCE_LENGTH];
+  std::uniform_int_distribution<int> byte(0, 255), digit(0, 9);
+
+  if (nec) {
+    unsigned int address = byte(_rnd);
+    IRCodes::encodeNec(&handle, address, byte(_rnd));
+  } else {
+    // random bytes with BCD digits for temperature and humidity.
+    uint8_t data[7] = {0x9f};
+    for (int n = 1; n < 7; n++)
+      data[n] = byte(_rnd);
+    for (int n = 4; n < 7; n++) {
+      if ((n != 5) && ((data[n] >> 4) > 9))
+        data[n] = (digit(_rnd) << 4) | (data[n] & 0x0f);
+      if ((data[n] & 0x0f) > 9)
+        data[n] = (data[n] & 0xf0) | digit(_rnd);
+    }
+    RFCodes::encodeCw(&handle, data);
+  }
+  handle.protocol = (SignalParser::Protocol *)p;
+
+  SignalParser::getText(&handle, text, sizeof(text));
+  const char *codes = strchr(text, ' ');
+  return (codes ? codes + 1 : "");
+} // _validCodes()
+
+
+int SignalGenerator::composeCodes(const SignalParser::Protocol *p, const char *codes, std::vector<SignalParser::CodeTime> &timings)
+{
+  int cnt = 0;
+  int level = 1;     // level of the next timing, the first one is high.
+  int lastHalf = -1; // level of the last timing when it ends with a half bit.
+  bool prefix = false;
+
+  // add a half bit of manchester mode, half bits with the same level are joined.
+  auto addHalf = [&](int half) {
+    if (half == lastHalf) {
+      timings.back() += p->baseTime;
+    } else {
+      timings.push_back(p->baseTime);
+      cnt++;
+      lastHalf = half;
+      level = 1 - half;
+    }
+  };
+
+  while (*codes) {
+    if (p->manchester && ((*codes == '0') || (*codes == '1'))) {
+      if (prefix)
+        addHalf(level); // the second half of the bit that ends the start code.
+      prefix = false;
+
+      int first = *codes - '0';
+      if (p->manchester & SignalParser::MANCHESTER_INVERT)
+        first = 1 - first;
+      addHalf(first);
+      addHalf(1 - first);
+      codes++;
+      continue;
+    }
+
+    for (int n = 0; (n < MAX_CODELENGTH) && p->codes[n].name; n++) {
+      const SignalParser::Code *c = &p->codes[n];
+      if (c->name == *codes) {
+        for (int i = 0; (i < MAX_TIMELENGTH) && c->time[i]; i++) {
+          timings.push_back(p->baseTime * c->time[i]);
+          cnt++;
+          level = 1 - level;
+        }
+        lastHalf = -1;
+        prefix = (p->manchester & SignalParser::MANCHESTER_MID);
+        break;
+      }
+    } // for
+    codes++;
+  } // while
+  return (cnt);
+} // composeCodes()
+
+
+void SignalGenerator::addFrame(const SignalParser::Protocol *p, const char *codes)
+{
+  std::vector<SignalParser::CodeTime> timings;
+  composeCodes(p, codes, timings);
+  if (timings.empty())
+    return;
+
+  if (_config.noiseGap > 0)
+    addNoise(std::poisson_distribution<int>(_config.noiseGap)(_rnd));
+  if (_config.silence > 0)
+    _add(_config.silence);
+
+  Frame f;
+  f.offset = _stream.size();
+  f.time = _time;
+  f.code = p->name;
+  f.code += ' ';
+  f.code += codes;
+
+  std::normal_distribution<double> jitter(0.0, _config.jitter / 100);
+  std::uniform_real_distribution<double> uniform(0.0, 1.0);
+
+  for (size_t i = 0; i < timings.size(); i++) {
+    double d = timings[i];
+
+    if ((_config.dropRate > 0) && (i + 1 < timings.size()) && (uniform(_rnd) < _config.dropRate)) {
+      // the edge to the next duration is lost.
+      i++;
+      d += timings[i];
+    }
+
+    d += (i % 2 == 0) ? _config.markSkew : _config.spaceSkew;
+    if (_config.jitter > 0)
+      d *= 1.0 + jitter(_rnd);
+
+    SignalParser::CodeTime t = (d < 1) ? 1 : (SignalParser::CodeTime)lround(d);
+
+    if ((_config.glitchRate > 0) && (t > 2) && (uniform(_rnd) < _config.glitchRate)) {
+      // split by a short glitch
+      SignalParser::CodeTime g = std::uniform_int_distribution<SignalParser::CodeTime>(1, _config.glitchTime)(_rnd);
+      SignalParser::CodeTime a = std::uniform_int_distribution<SignalParser::CodeTime>(1, t - 1)(_rnd);
+      _add(a);
+      _add(g);
+      _add((t > a + g) ? t - a - g : 1);
+
+    } else {
+      _add(t);
+    }
+  } // for
+
+  f.end = _stream.size() - 1;
+  _frames.push_back(f);
+} // addFrame()
+
+
+void SignalGenerator::addRandomFrames(const SignalParser::Protocol *p, int count)
+{
+  while (count-- > 0) {
+    std::string codes = randomCodes(p);
+    addFrame(p, codes.c_str());
+  }
+} // addRandomFrames()
+
+
+void SignalGenerator::addNoise(int count)
+{
+  while (count-- > 0)
+    _add(_noiseTime());
+} // addNoise()
+
+
+void SignalGenerator::_add(SignalParser::CodeTime t)
+{
+  _stream.push_back(t);
+  _time += t;
+} // _add()
+
+
+// log-uniform noise between 20 and 20000 µsecs
+SignalParser::CodeTime SignalGenerator::_noiseTime()
+{
+  return ((SignalParser::CodeTime)(20.0 * pow(1000.0, std::uniform_real_distribution<double>(0.0, 1.0)(_rnd))));
+} // _noiseTime()
+
+// End.
@@ -0,0 +1,127 @@
+/**
+ * @file: SignalGenerator.h
+ *
+ * This file is part of the RFCodes library that implements receiving an sending
+ * RF and IR protocols.
+ *
+ * @copyright Copyright (c) by Matthias Hertel, https://www.mathertel.de.
+ *
+ * This work is licensed under a BSD 3-Clause style license,
+ * https://www.mathertel.de/License.aspx.
+ *
+ * @brief
+ * Generator for synthetic timing streams with ground truth.
+ *
+ * Random valid frames of a protocol are composed using the ideal timings of
+ * the code table like SignalParser::compose(). The timings are then disturbed
+ * by the configured effects:
+ * * gaussian jitter in percent of every duration,
+ * * mark/space skew added to the first, third, ... resp. the second, fourth, ...
+ *   duration of a frame,
+ * * glitches that split a duration by a short pulse,
+ * * dropped edges that merge two durations,
+ * * random noise durations and silence between the frames.
+ *
+ * The generator keeps the stream and the list of the expected frames with the
+ * offset of their first and last duration in the stream. The same seed
+ * produces the same stream.
+ *
+ * Changelog:
+ * * 16.10.2026 created.
+ * * 16.10.2026 valid nec and cw frames for the validate functions.
+ * * 16.10.2026 manchester bits.
+ */
+
+#ifndef SignalGenerator_H_
+#define SignalGenerator_H_
+
+#include <random>
+#include <string>
+#include <vector>
+
+#include "SignalParser.h"
+
+class SignalGenerator
+{
+public:
+  struct Config {
+    double jitter = 0;      // standard deviation of the jitter in percent of a duration
+    int markSkew = 0;       // µsecs added to every mark
+    int spaceSkew = 0;      // µsecs added to every space
+    double glitchRate = 0;  // probability of a glitch per duration
+    SignalParser::CodeTime glitchTime = 40; // maximal length of a glitch in µsecs
+    double dropRate = 0;    // probability of a dropped edge per duration
+    double noiseGap = 0;    // average number of noise durations between frames
+    SignalParser::CodeTime silence = 0; // silence in µsecs before every frame, 0 for none
+  };
+
+  struct Frame {
+    size_t offset; // index of the first duration in the stream
+    size_t end;    // index of the last duration in the stream
+    unsigned long long time; // time of the frame start in µsecs
+    std::string code;        // "<protocol> <codes>"
+  };
+
+  SignalGenerator(unsigned long seed = 1);
+
+  /** use a new configuration for the following frames. */
+  void setConfig(const Config &config)
+  {
+    _config = config;
+  };
+
+  /** remove the stream and frames and restart the random generator with the seed. */
+  void clear(unsigned long seed);
+
+  /** create a random valid code sequence for the protocol.
+   * @param p the protocol.
+   * @return the sequence characters without the protocol name.
+   */
+  std::string randomCodes(const SignalParser::Protocol *p);
+
+  /** append the ideal timings of the sequence like SignalParser::compose().
+   * @param p the protocol.
+   * @param codes the sequence characters without the protocol name.
+   * @param timings the timings are appended here.
+   * @return number of appended timings.
+   */
+  static int composeCodes(const SignalParser::Protocol *p, const char *codes, std::vector<SignalParser::CodeTime> &timings);
+
+  /** add noise, a disturbed frame and remember the frame as expected. */
+  void addFrame(const SignalParser::Protocol *p, const char *codes);
+
+  /** add random frames of the protocol. */
+  void addRandomFrames(const SignalParser::Protocol *p, int count);
+
+  /** add random noise durations. */
+  void addNoise(int count);
+
+  /** the generated stream. */
+  const std::vector<SignalParser::CodeTime> &stream()
+  {
+    return (_stream);
+  };
+
+  /** the expected frames in the stream. */
+  const std::vector<Frame> &frames()
+  {
+    return (_frames);
+  };
+
+private:
+  Config _config;
+  std::mt19937 _rnd;
+  std::vector<SignalParser::CodeTime> _stream;
+  std::vector<Frame> _frames;
+  unsigned long long _time = 0; // time at the end of the stream
+
+  void _add(SignalParser::CodeTime t);
+  SignalParser::CodeTime _noiseTime();
+
+  // nec or cw codes with random values that pass the validate function.
+  std::string _validCodes(const SignalParser::Protocol *p, bool nec);
+}; // class SignalGenerator
+
+#endif // SignalGenerator_H_
+
+// End.
@@ -0,0 +1,121 @@
+/**
+ * @file TimingReader.cpp
+ *
+ * This file is part of the RFCodes library that implements receiving an sending
+ * RF and IR protocols.
+ *
+ * @copyright Copyright (c) by Matthias Hertel, https://www.mathertel.de.
+ *
+ * This work is licensed under a BSD 3-Clause style license,
+ * https://www.mathertel.de/License.aspx.
+ *
+ * @brief
+ * Read timing streams from memory for the host tools.
+ *
+ * Change History see TimingReader.h
+ */
+
+#include "TimingReader.h"
+
+#include <string.h>
+
+
+// separators between words in the text format.
+static bool _isSeparator(unsigned char c)
+{
+  return ((c == ',') || (c == ';') || (c == ' ') || (c == '\t') || (c == '\r') || (c == '\n'));
+} // _isSeparator()
+
+
+bool TimingReader::formatByName(const char *name, Format *format)
+{
+  if (strcmp(name, "text") == 0) {
+    *format = TEXT;
+  } else if (strcmp(name, "bin16") == 0) {
+    *format = BIN16;
+  } else if (strcmp(name, "bin32") == 0) {
+    *format = BIN32;
+  } else if (strcmp(name, "capture") == 0) {
+    *format = CAPTURE;
+  } else {
+    return (false);
+  }
+  return (true);
+} // formatByName()
+
+
+bool TimingReader::begin(const char *data, size_t len, Format format)
+{
+  _data = (const unsigned char *)data;
+  _len = data ? len : 0;
+  _pos = 0;
+  _format = format;
+
+  if (format == CAPTURE)
+    return (_capture.begin(_data, _len));
+  return (true);
+} // begin()
+
+
+int TimingReader::read(SignalParser::CodeTime *buffer, int len)
+{
+  if (_format == BIN16)
+    return (_readBinary(buffer, len, 2));
+  if (_format == BIN32)
+    return (_readBinary(buffer, len, 4));
+  if (_format == CAPTURE)
+    return (_capture.read(buffer, len));
+  return (_readText(buffer, len));
+} // read()
+
+
+int TimingReader::_readText(SignalParser::CodeTime *buffer, int len)
+{
+  int cnt = 0;
+
+  while ((cnt < len) && (_pos < _len)) {
+    // skip separators
+    while ((_pos < _len) && _isSeparator(_data[_pos]))
+      _pos++;
+
+    // scan one word
+    size_t start = _pos;
+    unsigned long value = 0;
+    bool number = true;
+
+    while ((_pos < _len) && !_isSeparator(_data[_pos])) {
+      unsigned char c = _data[_pos++];
+      if ((c >= '0') && (c <= '9') && number) {
+        value = value * 10 + (c - '0');
+        if (value > 0xFFFFFFFFUL)
+          number = false; // not a duration
+      } else {
+        number = false; // e.g. index labels "8:" or text
+      }
+    } // while
+
+    if (number && (_pos > start) && (value > 0)) {
+      buffer[cnt++] = (SignalParser::CodeTime)value;
+    }
+  } // while
+  return (cnt);
+} // _readText()
+
+
+int TimingReader::_readBinary(SignalParser::CodeTime *buffer, int len, int width)
+{
+  int cnt = 0;
+
+  while ((cnt < len) && (_pos + width <= _len)) {
+    const unsigned char *p = _data + _pos;
+    SignalParser::CodeTime value = p[0] | (p[1] << 8);
+    if (width == 4)
+      value |= ((SignalParser::CodeTime)p[2] << 16) | ((SignalParser::CodeTime)p[3] << 24);
+
+    buffer[cnt++] = value;
+    _pos += width;
+  } // while
+  return (cnt);
+} // _readBinary()
+
+// End.
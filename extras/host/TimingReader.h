@@ -0,0 +1,82 @@
+/**
+ * @file: TimingReader.h
+ *
+ * This file is part of the RFCodes library that implements receiving an sending
+ * RF and IR protocols.
+ *
+ * @copyright Copyright (c) by Matthias Hertel, https://www.mathertel.de.
+ *
+ * This work is licensed under a BSD 3-Clause style license,
+ * https://www.mathertel.de/License.aspx.
+ *
+ * @brief
+ * Read timing streams from memory for the host tools.
+ *
+ * Supported formats:
+ * * TEXT: the comma separated numbers printed by scanner.ino and
+ *   SignalCollector::dumpTimings(). Index labels like "  8:" and all words
+ *   that are not plain numbers are skipped. 0 values are skipped as they are
+ *   used as terminator in timing tables.
+ * * BIN16, BIN32: durations as little endian 16 or 32 bit unsigned values.
+ * * CAPTURE: the binary capture format, see SignalCapture.h.
+ *
+ * Changelog:
+ * * 16.10.2026 created.
+ * * 16.10.2026 capture format.
+ */
+
+#ifndef TimingReader_H_
+#define TimingReader_H_
+
+#include <stddef.h>
+
+#include "SignalCapture.h"
+#include "SignalParser.h"
+
+class TimingReader
+{
+public:
+  typedef enum {
+    TEXT,
+    BIN16,
+    BIN32,
+    CAPTURE
+  } Format;
+
+  /** get the format by name "text", "bin16", "bin32" or "capture".
+   * @return true when the name is known.
+   */
+  static bool formatByName(const char *name, Format *format);
+
+  /** start reading from a memory buffer that must stay valid while reading.
+   * @return false when the data is not in the capture format.
+   */
+  bool begin(const char *data, size_t len, Format format);
+
+  /** read the next durations.
+   * @param buffer target buffer.
+   * @param len size of the buffer.
+   * @return number of durations in the buffer, 0 at the end of the data.
+   */
+  int read(SignalParser::CodeTime *buffer, int len);
+
+  /** return the current read position in bytes. */
+  size_t position()
+  {
+    return ((_format == CAPTURE) ? _capture.position() : _pos);
+  };
+
+private:
+  const unsigned char *_data = nullptr;
+  size_t _len = 0;
+  size_t _pos = 0;
+  Format _format = TEXT;
+  CaptureReader _capture;
+
+  int _readText(SignalParser::CodeTime *buffer, int len);
+  int _readBinary(SignalParser::CodeTime *buffer, int len, int width);
+}; // class TimingReader
+
+#endif // TimingReader_H_
+
+// End.
@@ -0,0 +1,26 @@
+# gendecode.cmake
+#
+# Compare the frames decoded by rfdecode with the expected frames written by
+# rfgen for the same stream. Used by ctest, see CMakeLists.txt.
+#
+# cmake -DRFGEN=<rfgen> -DRFDECODE=<rfdecode> -DPROTOCOLS=<list> -DDIR=<dir> -P gendecode.cmake
+
+set(STREAM ${DIR}/gendecode_${PROTOCOLS}_stream.txt)
+set(EXPECTED ${DIR}/gendecode_${PROTOCOLS}_expected.txt)
+set(DECODED ${DIR}/gendecode_${PROTOCOLS}_decoded.txt)
+
+execute_process(COMMAND ${RFGEN} -p ${PROTOCOLS} -n 300 -j 3 -w 30000 -o ${STREAM} -e ${EXPECTED}
+  RESULT_VARIABLE ret)
+if(ret)
+  message(FATAL_ERROR "rfgen failed")
+endif()
+
+execute_process(COMMAND ${RFDECODE} ${STREAM} OUTPUT_FILE ${DECODED} RESULT_VARIABLE ret)
+if(ret)
+  message(FATAL_ERROR "rfdecode failed")
+endif()
+
+execute_process(COMMAND ${CMAKE_COMMAND} -E compare_files ${EXPECTED} ${DECODED} RESULT_VARIABLE ret)
+if(ret)
+  message(FATAL_ERROR "the decoded frames differ from ${EXPECTED}, see ${DECODED}")
+endif()
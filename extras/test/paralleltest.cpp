@@ -0,0 +1,104 @@
+/**
+ * @file paralleltest.cpp
+ *
+ * This file is part of the RFCodes library that implements receiving an sending
+ * RF and IR protocols.
+ *
+ * @copyright Copyright (c) by Matthias Hertel, https://www.mathertel.de.
+ *
+ * This work is licensed under a BSD 3-Clause style license,
+ * https://www.mathertel.de/License.aspx.
+ *
+ * @brief
+ * Test of the ParallelDecoder against a single SignalParser.
+ *
+ * A stream of the manchester protocols rc5 and cw with noise is decoded with
+ * the smallest possible gap and small chunks so the stream is split as often
+ * as possible. The frames must be the same as found by a single parser. The
+ * full bits of rc5 are longer than all codes, so splitting the stream inside
+ * of the frames would lose them.
+ *
+ * The program returns 1 when a check failed and is run by ctest.
+ *
+ * Changelog:
+ * * 16.10.2026 created.
+ */
+
+#include <stdio.h>
+
+#include "ParallelDecoder.h"
+#include "SignalGenerator.h"
+#include "ircodes.h"
+#include "protocols.h"
+
+static SignalParser sig;
+static std::vector<ParallelDecoder::Frame> sequential;
+static int failed = 0;
+
+
+static void check(bool ok, const char *msg)
+{
+  if (!ok) {
+    printf("failed: %s\n", msg);
+    failed++;
+  }
+} // check()
+
+
+static void receiveCode(const char *code)
+{
+  sequential.push_back({(unsigned long long)sig.getBatchIndex(), code});
+} // receiveCode()
+
+
+int main()
+{
+  SignalParser::Protocol rc5 = IRCodes::rc5;
+  SignalParser::Protocol cw = RFCodes::cw;
+
+  SignalGenerator gen(7);
+  SignalGenerator::Config config;
+  config.jitter = 4;
+  config.noiseGap = 8;
+  gen.setConfig(config);
+  for (int n = 0; n < 20; n++) {
+    gen.addRandomFrames(&rc5, 5);
+    gen.addRandomFrames(&cw, 2);
+  }
+  const std::vector<SignalParser::CodeTime> &stream = gen.stream();
+
+  // a single parser for the whole stream.
+  sig.load(&rc5);
+  sig.load(&cw);
+  sig.attachCallback(receiveCode);
+  sig.parse(stream.data(), (int)stream.size());
+
+  // split the stream after every duration above the protocol limits.
+  std::vector<ParallelDecoder::Frame> parallel;
+  ParallelDecoder dec(4);
+  dec.load(&IRCodes::rc5);
+  dec.load(&RFCodes::cw);
+  dec.setGap(1);
+  dec.setChunkSize(1);
+  dec.decode(stream.data(), stream.size(), true, parallel);
+
+  printf("%d durations, gap %d, %d frames sequential, %d frames parallel\n",
+         (int)stream.size(), (int)dec.gap(), (int)sequential.size(), (int)parallel.size());
+
+  check(dec.gap() > rc5.halfMax[1], "gap above the rc5 full bit");
+  check(!sequential.empty(), "frames found");
+  check(parallel.size() == sequential.size(), "number of frames");
+  for (size_t n = 0; (n < parallel.size()) && (n < sequential.size()); n++) {
+    if ((parallel[n].index != sequential[n].index) || (parallel[n].code != sequential[n].code)) {
+      printf("  %llu %s <> %llu %s\n", sequential[n].index, sequential[n].code.c_str(),
+             parallel[n].index, parallel[n].code.c_str());
+      check(false, "same frame");
+      break;
+    }
+  } // for
+
+  printf("paralleltest: %d failed\n", failed);
+  return (failed ? 1 : 0);
+} // main()
+
+// End.
@@ -0,0 +1,149 @@
+/**
+ * @file parsertest.cpp
+ *
+ * This file is part of the RFCodes library that implements receiving an sending
+ * RF and IR protocols.
+ *
+ * @copyright Copyright (c) by Matthias Hertel, https://www.mathertel.de.
+ *
+ * This work is licensed under a BSD 3-Clause style license,
+ * https://www.mathertel.de/License.aspx.
+ *
+ * @brief
+ * Test of the SignalParser with streams of composed timings.
+ *
+ * A nec frame is cut after a few bits and followed by a repeat code. The
+ * repeat code must be found alone and must not end the partial frame, also
+ * without the validate function of nec.
+ *
+ * The decoder reports a repeat code that follows a nec command as a held
+ * button and drops a repeat code that comes after a long silence. The times
+ * are taken from the parsed durations.
+ *
+ * The program returns 1 when a check failed and is run by ctest.
+ *
+ * Changelog:
+ * * 16.10.2026 created.
+ * * 16.10.2026 held and stale nec repeat codes.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <string>
+#include <vector>
+
+#include "SignalDecoder.h"
+#include "SignalParser.h"
+#include "ircodes.h"
+
+static SignalParser sig;
+static SignalDecoder dec;
+static std::vector<std::string> decoded;
+static std::vector<SignalDecoder::Record> records;
+static int failed = 0;
+
+
+static void check(bool ok, const char *msg)
+{
+  if (!ok) {
+    printf("failed: %s\n", msg);
+    failed++;
+  }
+} // check()
+
+
+static void receiveCode(const char *code)
+{
+  decoded.push_back(code);
+} // receiveCode()
+
+
+static void receiveRecord(const SignalDecoder::Record *record)
+{
+  records.push_back(*record);
+} // receiveRecord()
+
+
+// append the timings of a sequence to the stream.
+static void append(std::vector<SignalParser::CodeTime> &stream, const char *sequence, int count = -1)
+{
+  std::vector<SignalParser::CodeTime> timings(sig.compose(sequence, nullptr, 0) + 1);
+  int len = sig.compose(sequence, timings.data(), (int)timings.size());
+  if ((count < 0) || (count > len))
+    count = len;
+  stream.insert(stream.end(), timings.begin(), timings.begin() + count);
+} // append()
+
+
+// a truncated nec frame followed by a repeat code.
+static void truncatedRepeat()
+{
+  std::vector<SignalParser::CodeTime> stream;
+  append(stream, "nec N00000000111111110100000010111111", 2 + 2 * 4); // N and 4 bits.
+  append(stream, "nec R");
+  stream.push_back(20000); // silence
+
+  decoded.clear();
+  sig.reset();
+  sig.parse(stream.data(), (int)stream.size());
+
+  for (const std::string &s : decoded) {
+    printf("  %s\n", s.c_str());
+  }
+  check(decoded.size() == 1, "one sequence");
+  check(!decoded.empty() && (decoded[0] == "nec R"), "repeat code found");
+} // truncatedRepeat()
+
+
+// a nec command with a repeat code in time and a stale repeat code.
+static void heldRepeat()
+{
+  std::vector<SignalParser::CodeTime> stream;
+  append(stream, "nec N00000000111111110100000010111111");
+  stream.push_back(560);   // stop bit
+  stream.push_back(40000); // next code about 108 msecs after the command
+  append(stream, "nec R");
+  stream.push_back(560);
+  stream.push_back(200000); // more than SIGNALDECODER_HOLD_TIMEOUT
+  append(stream, "nec R");
+  stream.push_back(560);
+  stream.push_back(20000);
+
+  decoded.clear();
+  records.clear();
+  sig.reset();
+  sig.parse(stream.data(), (int)stream.size());
+
+  for (const SignalDecoder::Record &r : records) {
+    printf("  nec %02x %02x repeat=%d held=%lu\n", r.nec.address, r.nec.command, r.nec.repeat, r.nec.held);
+  }
+  check(decoded.size() == 3, "three sequences");
+  check(records.size() == 2, "command and one repeat");
+  check((records.size() > 1) && (records[1].nec.repeat == 1), "repeat of the command");
+  check((records.size() > 1) && (records[1].nec.held < SIGNALDECODER_HOLD_TIMEOUT), "held time");
+} // heldRepeat()
+
+
+int main()
+{
+  sig.load(&IRCodes::nec);
+  sig.attachCallback(receiveCode);
+
+  printf("truncated frame and repeat code:\n");
+  truncatedRepeat();
+
+  printf("without validate function:\n");
+  sig.attachValidator("nec", nullptr);
+  truncatedRepeat();
+
+  printf("held and stale repeat codes:\n");
+  dec.attachAll();
+  dec.attachRecordCallback(receiveRecord);
+  sig.attachDecoder(&dec);
+  heldRepeat();
+
+  printf("parsertest: %d failed\n", failed);
+  return (failed ? 1 : 0);
+} // main()
+
+// End.
@@ -0,0 +1,74 @@
+/**
+ * @file sampletest.cpp
+ *
+ * This file is part of the RFCodes library that implements receiving an sending
+ * RF and IR protocols.
+ *
+ * @copyright Copyright (c) by Matthias Hertel, https://www.mathertel.de.
+ *
+ * This work is licensed under a BSD 3-Clause style license,
+ * https://www.mathertel.de/License.aspx.
+ *
+ * @brief
+ * Test of the SignalParser with the recorded sample data.
+ *
+ * The timings of the testcodes example are parsed with the it1, it2, sc5 and
+ * cw protocols. The found sequences must be SampleData::testresults in the same
+ * order, so a change of the parser that decodes other frames is found even when
+ * the number of frames in parserbench is the same.
+ *
+ * The program returns 1 when a check failed and is run by ctest.
+ *
+ * Changelog:
+ * * 16.10.2026 created.
+ */
+
+#include <stdio.h>
+#include <string>
+#include <vector>
+
+#include "SignalParser.h"
+#include "protocols.h"
+
+#include "SampleData.h"
+
+static SignalParser sig;
+static std::vector<std::string> decoded;
+
+
+static void receiveCode(const char *code)
+{
+  decoded.push_back(code);
+} // receiveCode()
+
+
+int main()
+{
+  int failed = 0;
+
+  sig.load(&RFCodes::it1);
+  sig.load(&RFCodes::it2);
+  sig.load(&RFCodes::sc5);
+  sig.load(&RFCodes::cw);
+  sig.attachCallback(receiveCode);
+
+  sig.parse(SampleData::testcodes, SampleData::count(SampleData::testcodes));
+
+  size_t n = 0;
+  for (; SampleData::testresults[n]; n++) {
+    const char *found = (n < decoded.size()) ? decoded[n].c_str() : "";
+    if ((n >= decoded.size()) || (decoded[n] != SampleData::testresults[n])) {
+      printf("failed: frame %d is [%s], expected [%s]\n", (int)n, found, SampleData::testresults[n]);
+      failed++;
+    }
+  } // for
+  for (; n < decoded.size(); n++) {
+    printf("failed: unexpected frame [%s]\n", decoded[n].c_str());
+    failed++;
+  }
+
+  printf("sampletest: %d frames, %d failed\n", (int)decoded.size(), failed);
+  return (failed ? 1 : 0);
+} // main()
+
+// End.
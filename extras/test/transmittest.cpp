@@ -0,0 +1,124 @@
+/**
+ * @file transmittest.cpp
+ *
+ * This file is part of the RFCodes library that implements receiving an sending
+ * RF and IR protocols.
+ *
+ * @copyright Copyright (c) by Matthias Hertel, https://www.mathertel.de.
+ *
+ * This work is licensed under a BSD 3-Clause style license,
+ * https://www.mathertel.de/License.aspx.
+ *
+ * @brief
+ * Test of the SignalTransmitter queue using the simulation backend.
+ *
+ * The sent callback queues the same sequence again by send(). Every sequence
+ * must be sent with the number of repeats of the protocol and decoded from the
+ * output pin as often. The test runs with the timer and blocking without a
+ * timer.
+ *
+ * The program returns 1 when a check failed and is run by ctest.
+ *
+ * Changelog:
+ * * 16.10.2026 created.
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "SignalHalSim.h"
+#include "SignalTransmitter.h"
+#include "protocols.h"
+
+#define SEND_PIN 1
+#define CODE "it1 B000110000000"
+
+static SignalParser sig;
+static SignalTransmitter tx;
+
+static unsigned long lastEdge = 0;
+static bool started = false;
+static int decoded = 0;
+static int sentCount = 0;
+static int failed = 0;
+
+
+static void check(bool ok, const char *msg)
+{
+  if (!ok) {
+    printf("failed: %s\n", msg);
+    failed++;
+  }
+} // check()
+
+
+static void receiveCode(const char *code)
+{
+  check(strcmp(code, CODE) == 0, "decoded code");
+  decoded++;
+} // receiveCode()
+
+
+// send the code again from the callback the first time.
+static void codeSent(const char *code, const SignalTransmitter::SendInfo *info)
+{
+  check(strcmp(code, CODE) == 0, "sent code");
+  check(info->repeats == (int)RFCodes::it1.sendRepeat, "repeats in the sent callback");
+  sentCount++;
+  if (sentCount == 1)
+    check(tx.send(CODE), "send() from the sent callback");
+} // codeSent()
+
+
+// decode the durations between the edges of the send pin.
+static void outputEdge(int pin, int, unsigned long now)
+{
+  if (pin == SEND_PIN) {
+    if (started)
+      sig.parse((SignalParser::CodeTime)(now - lastEdge));
+    lastEdge = now;
+    started = true;
+  }
+} // outputEdge()
+
+
+static void sendTwice(bool timer)
+{
+  started = false;
+  decoded = 0;
+  sentCount = 0;
+
+  SignalHalSim::reset();
+  SignalHalSim::setTimer(timer);
+  tx.init(&sig, SEND_PIN);
+  tx.attachSentCallback(codeSent);
+  SignalHalSim::setOutputHook(outputEdge);
+
+  check(tx.send(CODE), "send()");
+  while (tx.isSending()) {
+    while (SignalHalSim::runTimer()) {
+      // the edges are written by the timer.
+    }
+    tx.loop();
+  }
+
+  check(sentCount == 2, "number of sent callbacks");
+  check(decoded == 2, "number of decoded copies");
+  printf("%-9s %d sent, %d decoded\n", timer ? "timer:" : "blocking:", sentCount, decoded);
+} // sendTwice()
+
+
+int main()
+{
+  RFCodes::it1.sendRepeat = 1;
+  sig.load(&RFCodes::it1);
+  sig.attachCallback(receiveCode);
+
+  sendTwice(true);
+  sendTwice(false);
+
+  printf("transmittest: %d failed\n", failed);
+  return (failed ? 1 : 0);
+} // main()
+
+// End.
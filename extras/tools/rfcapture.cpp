@@ -0,0 +1,170 @@
+/**
+ * @file rfcapture.cpp
+ *
+ * This file is part of the RFCodes library that implements receiving an sending
+ * RF and IR protocols.
+ *
+ * @copyright Copyright (c) by Matthias Hertel, https://www.mathertel.de.
+ *
+ * This work is licensed under a BSD 3-Clause style license,
+ * https://www.mathertel.de/License.aspx.
+ *
+ * @brief
+ * Convert timing streams to the binary capture format and back, see
+ * SignalCapture.h.
+ *
+ * * Without -d the input in any format is written as a capture.
+ * * With -d a capture is printed as text with the header settings on stderr.
+ *   Using -x the output starts at the given index found by the sync markers.
+ *
+ * Changelog:
+ * * 16.10.2026 created.
+ * * 16.10.2026 memory mapped input.
+ */
+
+#include <chrono>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "SignalCapture.h"
+
+#include "MappedFile.h"
+#include "TimingReader.h"
+
+#define BATCH_SIZE 4096 // durations read at once
+
+static FILE *out = nullptr;
+
+// sink of the capture writer.
+static void writeCapture(const uint8_t *data, size_t len)
+{
+  fwrite(data, 1, len, out);
+} // writeCapture()
+
+
+static void usage()
+{
+  fprintf(stderr,
+          "usage: rfcapture [-f format] [-i id] [-t start] [-l level] [-y count] [-o file] [file]\n"
+          "       rfcapture -d [-x index] [-o file] [file]\n"
+          "  -f  input format: text, bin16 or bin32, default: text\n"
+          "  -i  receiver id, default: 0\n"
+          "  -t  start timestamp in µsecs, default: 0\n"
+          "  -l  level of the first duration: 0, 1 or 2 for unknown, default: 2\n"
+          "  -y  durations between sync markers, default: 1024\n"
+          "  -d  print a capture as text\n"
+          "  -x  start printing at the duration with this index\n"
+          "  -o  output file, default: stdout\n"
+          "Reads from stdin when no file or '-' is given.\n");
+} // usage()
+
+
+int main(int argc, char *argv[])
+{
+  TimingReader::Format format = TimingReader::TEXT;
+  CaptureHeader header;
+  bool decode = false;
+  unsigned long startIndex = 0;
+  const char *outFile = nullptr;
+  int opt;
+
+  while ((opt = getopt(argc, argv, "f:i:t:l:y:dx:o:h")) != -1) {
+    if ((opt == 'f') && TimingReader::formatByName(optarg, &format)) {
+      // format is set
+    } else if (opt == 'i') {
+      header.receiverId = strtoul(optarg, nullptr, 0);
+    } else if (opt == 't') {
+      header.startTime = strtoull(optarg, nullptr, 0);
+    } else if (opt == 'l') {
+      header.level = (uint8_t)atoi(optarg);
+    } else if (opt == 'y') {
+      header.syncInterval = strtoul(optarg, nullptr, 0);
+    } else if (opt == 'd') {
+      decode = true;
+    } else if (opt == 'x') {
+      startIndex = strtoul(optarg, nullptr, 0);
+    } else if (opt == 'o') {
+      outFile = optarg;
+    } else {
+      usage();
+      return (2);
+    }
+  } // while
+
+  const char *fileName = (optind < argc) ? argv[optind] : "-";
+  MappedFile file;
+  if (!file.open(fileName)) {
+    fprintf(stderr, "rfcapture: cannot open '%s'\n", fileName);
+    return (1);
+  }
+  const char *data = file.data();
+  size_t len = file.size();
+
+  out = outFile ? fopen(outFile, "wb") : stdout;
+  if (!out) {
+    fprintf(stderr, "rfcapture: cannot write '%s'\n", outFile);
+    return (1);
+  }
+
+  SignalParser::CodeTime buffer[BATCH_SIZE];
+  unsigned long long count = 0;
+  int cnt;
+  int ret = 0;
+  auto start = std::chrono::steady_clock::now();
+
+  if (decode) {
+    CaptureReader reader;
+    if (!reader.begin((const uint8_t *)data, len)) {
+      fprintf(stderr, "rfcapture: '%s' is not a capture file\n", fileName);
+      return (1);
+    }
+
+    const CaptureHeader &h = reader.header();
+    fprintf(stderr, "resolution:%lu ns receiver:%lu start:%llu level:%u sync:%lu\n",
+            (unsigned long)h.resolution, (unsigned long)h.receiverId,
+            (unsigned long long)h.startTime, h.level, (unsigned long)h.syncInterval);
+
+    if (startIndex && !reader.seek(startIndex)) {
+      fprintf(stderr, "rfcapture: index %lu is not in the capture\n", startIndex);
+      ret = 1;
+    } else if (startIndex) {
+      fprintf(stderr, "index:%lu time:%llu\n", (unsigned long)reader.index(), (unsigned long long)reader.time());
+    }
+
+    while ((cnt = reader.read(buffer, BATCH_SIZE)) > 0) {
+      for (int n = 0; n < cnt; n++) {
+        fprintf(out, (count % 32 == 31) ? "%u,\n" : "%u,", buffer[n]);
+        count++;
+      }
+      file.release(reader.position());
+    } // while
+    if (count % 32)
+      fputc('\n', out);
+
+  } else {
+    TimingReader reader;
+    CaptureWriter writer;
+
+    reader.begin(data, len, format);
+    writer.begin(header, writeCapture);
+    while ((cnt = reader.read(buffer, BATCH_SIZE)) > 0) {
+      for (int n = 0; n < cnt; n++) {
+        writer.write(buffer[n]);
+      }
+      count += cnt;
+      file.release(reader.position());
+    } // while
+    writer.flush();
+  }
+
+  double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  fprintf(stderr, "%llu durations, %zu bytes input, %.3f ms\n", count, len, seconds * 1000);
+
+  if (out != stdout)
+    fclose(out);
+  return (ret);
+} // main()
+
+// End.
@@ -0,0 +1,342 @@
+/**
+ * @file rfdecode.cpp
+ *
+ * This file is part of the RFCodes library that implements receiving an sending
+ * RF and IR protocols.
+ *
+ * @copyright Copyright (c) by Matthias Hertel, https://www.mathertel.de.
+ *
+ * This work is licensed under a BSD 3-Clause style license,
+ * https://www.mathertel.de/License.aspx.
+ *
+ * @brief
+ * Offline decoder for timing captures.
+ *
+ * The timing streams are read from files or stdin and passed through the
+ * SignalParser with a chosen set of protocols. The decoded frames are printed
+ * with the offset of the first duration and the time of the frame start:
+ *
+ *     <offset> <time in µsecs> [<protocol> <codes>]
+ *
+ * Files are memory mapped and the durations are decoded in batches while
+ * streaming through the file, so the memory usage does not depend on the size
+ * of the file.
+ *
+ * With -g the durations are passed through the SignalSegmenter that drops
+ * bursts of noise before the parser.
+ *
+ * With -j the stream is split at silence gaps and decoded on multiple threads
+ * using the ParallelDecoder with the same output.
+ *
+ * A summary with the throughput in durations per second is printed to stderr.
+ * With -S the statistics counters of every protocol are printed to stderr too.
+ *
+ * Changelog:
+ * * 16.10.2026 created.
+ * * 16.10.2026 print the statistics counters.
+ * * 16.10.2026 memory mapped input and batch parsing.
+ * * 16.10.2026 parallel decoding with -j.
+ * * 16.10.2026 segmentation stage with -g.
+ * * 16.10.2026 rejected counter in the statistics.
+ * * 16.10.2026 frame offset of manchester protocols.
+ */
+
+#include <chrono>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <vector>
+
+#include "SignalParser.h"
+#include "SignalSegmenter.h"
+
+#include "MappedFile.h"
+#include "ParallelDecoder.h"
+#include "ProtocolTable.h"
+#include "TimingReader.h"
+
+#define BATCH_SIZE 4096   // durations read and parsed at once
+#define HISTORY_SIZE 8192 // recent durations to calculate the frame start, > BATCH_SIZE + MAX_TIMING_LENGTH
+#define WINDOW_SIZE (1024 * 1024) // durations passed to the parallel decoder at once
+
+static SignalParser sig;
+static SignalSegmenter seg;
+
+static bool quiet = false;
+static bool statistics = false;
+static bool segment = false;
+static const char *fileLabel = nullptr; // file name prefix when decoding multiple files
+
+static unsigned long long offset = 0;     // index of the first duration of the current batch in the stream
+static unsigned long long streamTime = 0; // time in µsecs at the end of the current batch
+static unsigned long long frameCount = 0;
+
+static SignalParser::CodeTime history[HISTORY_SIZE];   // recent durations
+static unsigned long long historyEnd[HISTORY_SIZE]; // time at the end of the recent durations
+
+
+// print a decoded frame with the offset and time of the first duration.
+// @param pos index of the duration that completed the frame.
+static void printFrame(unsigned long long pos, const char *code)
+{
+  frameCount++;
+  if (quiet)
+    return;
+
+  // find the number of durations in the frame
+  char protname[PROTNAME_LEN];
+  int len = 0;
+  while (code[len] && (code[len] != ' ') && (len < PROTNAME_LEN - 1)) {
+    protname[len] = code[len];
+    len++;
+  }
+  protname[len] = NUL;
+
+  int cnt = 1;
+  SignalParser::Protocol *p = ProtocolTable::find(protname);
+  if (p && code[len]) {
+    cnt = ProtocolTable::timingCount(p, code + len + 1);
+
+    if (p->manchester && ((int)strlen(code + len + 1) == (int)p->maxCodeLen)) {
+      // a complete frame ends with the first half of the last bit.
+      cnt--;
+    } else if (p->manchester) {
+      // a shorter frame ends with the duration after the last half bit.
+      cnt++;
+    }
+  }
+  if (cnt > HISTORY_SIZE - BATCH_SIZE)
+    cnt = HISTORY_SIZE - BATCH_SIZE;
+  if ((unsigned long long)cnt > pos + 1)
+    cnt = (int)(pos + 1);
+  if (cnt < 1)
+    cnt = 1;
+
+  unsigned long long first = pos + 1 - cnt;
+  unsigned long long frameTime = historyEnd[first % HISTORY_SIZE] - history[first % HISTORY_SIZE];
+
+  if (fileLabel)
+    printf("%s:", fileLabel);
+  printf("%llu %llu [%s]\n", first, frameTime, code);
+} // printFrame()
+
+
+// add a duration to the history.
+static void addHistory(unsigned long long pos, SignalParser::CodeTime duration)
+{
+  unsigned int h = pos % HISTORY_SIZE;
+  streamTime += duration;
+  history[h] = duration;
+  historyEnd[h] = streamTime;
+} // addHistory()
+
+
+static void receiveCode(const char *code)
+{
+  printFrame(segment ? seg.getParseIndex() : offset + sig.getBatchIndex(), code);
+} // receiveCode()
+
+
+// add the decoded durations to the history and print the frames found in them.
+static void printDecoded(const SignalParser::CodeTime *durations, size_t count, const std::vector<ParallelDecoder::Frame> &frames)
+{
+  size_t f = 0;
+  for (size_t i = 0; i < count; i++) {
+    addHistory(offset + i, durations[i]);
+    while ((f < frames.size()) && (frames[f].index == offset + i)) {
+      printFrame(frames[f].index, frames[f].code.c_str());
+      f++;
+    }
+  } // for
+  offset += count;
+} // printDecoded()
+
+
+static void usage()
+{
+  fprintf(stderr,
+          "usage: rfdecode [-p protocols] [-f format] [-g | -j threads] [-q] [-S] [file ...]\n"
+          "  -p  comma separated list of protocols, default: all (");
+  for (const ProtocolTable::Entry *e = ProtocolTable::all; e->name; e++) {
+    fprintf(stderr, "%s%s", e->name, e[1].name ? "," : ")\n");
+  }
+  fprintf(stderr,
+          "  -f  input format: text, bin16, bin32 or capture, default: text\n"
+          "  -g  drop bursts of noise by the segmenter before parsing\n"
+          "  -j  decode on multiple threads, 0 for all cores\n"
+          "  -q  print the summary only\n"
+          "  -S  print the statistics counters of every protocol\n"
+          "Reads from stdin when no file or '-' is given.\n");
+} // usage()
+
+
+int main(int argc, char *argv[])
+{
+  const char *protocols = nullptr;
+  TimingReader::Format format = TimingReader::TEXT;
+  int threads = -1; // sequential decoding
+  int opt;
+
+  while ((opt = getopt(argc, argv, "p:f:gj:qSh")) != -1) {
+    if (opt == 'p') {
+      protocols = optarg;
+    } else if ((opt == 'f') && TimingReader::formatByName(optarg, &format)) {
+      // format is set
+    } else if (opt == 'g') {
+      segment = true;
+    } else if (opt == 'j') {
+      threads = atoi(optarg);
+    } else if (opt == 'q') {
+      quiet = true;
+    } else if (opt == 'S') {
+      statistics = true;
+    } else {
+      usage();
+      return (2);
+    }
+  } // while
+
+  if (ProtocolTable::load(&sig, protocols) <= 0) {
+    fprintf(stderr, "rfdecode: unknown protocol in '%s'\n", protocols);
+    usage();
+    return (2);
+  }
+  sig.attachCallback(receiveCode);
+
+  if (segment && (threads >= 0)) {
+    fprintf(stderr, "rfdecode: -g and -j cannot be combined\n");
+    usage();
+    return (2);
+  }
+  seg.init(segment ? &sig : nullptr);
+
+  ParallelDecoder *dec = nullptr;
+  if (threads >= 0) {
+    SignalParser::Protocol *list[32];
+    int cnt = ProtocolTable::select(protocols, list, 32);
+    dec = new ParallelDecoder(threads);
+    for (int n = 0; n < cnt; n++) {
+      dec->load(list[n]);
+    }
+  }
+
+  static const char *stdinFiles[] = {"-"};
+  const char *const *files = argv + optind;
+  int fileCount = argc - optind;
+  if (fileCount == 0) {
+    files = stdinFiles;
+    fileCount = 1;
+  }
+
+  unsigned long long totalDurations = 0;
+  std::chrono::nanoseconds parseTime(0);
+  int ret = 0;
+
+  for (int n = 0; n < fileCount; n++) {
+    const char *fileName = files[n];
+    MappedFile file;
+
+    if (!file.open(fileName)) {
+      fprintf(stderr, "rfdecode: cannot open '%s'\n", fileName);
+      ret = 1;
+      continue;
+    }
+
+    fileLabel = (fileCount > 1) ? fileName : nullptr;
+    offset = 0;
+    streamTime = 0;
+    seg.reset();
+    sig.reset();
+
+    TimingReader reader;
+    if (!reader.begin(file.data(), file.size(), format)) {
+      fprintf(stderr, "rfdecode: '%s' is not a capture file\n", fileName);
+      ret = 1;
+      continue;
+    }
+
+    SignalParser::CodeTime buffer[BATCH_SIZE];
+    int cnt;
+
+    if (dec) {
+      // collect a window of durations and decode up to the last gap in it.
+      std::vector<SignalParser::CodeTime> window;
+      std::vector<ParallelDecoder::Frame> frames;
+      size_t windowSize = WINDOW_SIZE;
+      bool last = false;
+
+      dec->reset();
+      while (!last) {
+        cnt = reader.read(buffer, BATCH_SIZE);
+        window.insert(window.end(), buffer, buffer + (cnt > 0 ? cnt : 0));
+        file.release(reader.position());
+        last = (cnt <= 0);
+        if (!last && (window.size() < windowSize))
+          continue;
+
+        auto start = std::chrono::steady_clock::now();
+        size_t done = dec->decode(window.data(), window.size(), last, frames);
+        parseTime += std::chrono::steady_clock::now() - start;
+
+        printDecoded(window.data(), done, frames);
+        window.erase(window.begin(), window.begin() + done);
+        frames.clear();
+
+        // grow the window when no gap was found.
+        windowSize = (done ? WINDOW_SIZE : 2 * window.size());
+      } // while
+
+    } else {
+      while ((cnt = reader.read(buffer, BATCH_SIZE)) > 0) {
+        for (int i = 0; i < cnt; i++) {
+          addHistory(offset + i, buffer[i]);
+        }
+
+        auto start = std::chrono::steady_clock::now();
+        if (segment) {
+          for (int i = 0; i < cnt; i++) {
+            seg.parse(buffer[i]);
+          }
+        } else {
+          sig.parse(buffer, cnt);
+        }
+        parseTime += std::chrono::steady_clock::now() - start;
+
+        offset += cnt;
+        file.release(reader.position());
+      } // while
+    }
+    totalDurations += offset;
+  } // for
+
+  double seconds = parseTime.count() / 1e9;
+  fprintf(stderr, "%llu durations, %llu frames, %.3f ms, %.0f durations/sec\n",
+          totalDurations, frameCount, seconds * 1000,
+          seconds > 0 ? totalDurations / seconds : 0.0);
+
+  if (segment) {
+    SignalSegmenter::Statistics st;
+    seg.getStatistics(&st);
+    fprintf(stderr, "segmenter: %lu of %lu durations passed, %lu bursts, %lu dropped\n",
+            st.passed, st.durations, st.bursts, st.dropped);
+  }
+
+  if (statistics) {
+    fprintf(stderr, "protocol durations starts symbols notstart outofwindow fragments frames rejected retries\n");
+    for (const ProtocolTable::Entry *e = ProtocolTable::all; e->name; e++) {
+      SignalParser::Statistics st;
+      bool found = dec ? dec->getStatistics(e->protocol->name, &st) : sig.getStatistics(e->protocol->name, &st);
+      if (found) {
+        fprintf(stderr, "%-8s %lu %lu %lu %lu %lu %lu %lu %lu %lu\n", e->protocol->name,
+                st.durations, st.starts, st.symbols, st.notStart, st.outOfWindow,
+                st.fragments, st.frames, st.rejected, st.retries);
+      }
+    } // for
+  } // if
+
+  delete dec;
+  return (ret);
+} // main()
+
+// End.
@@ -0,0 +1,181 @@
+/**
+ * @file rfgen.cpp
+ *
+ * This file is part of the RFCodes library that implements receiving an sending
+ * RF and IR protocols.
+ *
+ * @copyright Copyright (c) by Matthias Hertel, https://www.mathertel.de.
+ *
+ * This work is licensed under a BSD 3-Clause style license,
+ * https://www.mathertel.de/License.aspx.
+ *
+ * @brief
+ * Generate synthetic timing streams with jitter, skew, glitches, dropped edges
+ * and noise using the SignalGenerator.
+ *
+ * The stream is written in the text, bin32 or capture format that can be read
+ * by rfdecode. The expected frames are written in the same format as rfdecode
+ * prints the decoded frames:
+ *
+ *     <offset> <time in µsecs> [<protocol> <codes>]
+ *
+ * Changelog:
+ * * 16.10.2026 created.
+ * * 16.10.2026 capture format output.
+ */
+
+#include <random>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "SignalCapture.h"
+
+#include "ProtocolTable.h"
+#include "SignalGenerator.h"
+
+static FILE *streamOut = nullptr;
+
+// sink of the capture writer.
+static void writeCapture(const uint8_t *data, size_t len)
+{
+  fwrite(data, 1, len, streamOut);
+} // writeCapture()
+
+
+static void usage()
+{
+  fprintf(stderr,
+          "usage: rfgen [options]\n"
+          "  -p list   comma separated list of protocols, default: all\n"
+          "  -n count  number of frames, default: 100\n"
+          "  -s seed   seed of the random generator, default: 1\n"
+          "  -j pct    gaussian jitter in percent (standard deviation), default: 0\n"
+          "  -m us     mark skew in µsecs, default: 0\n"
+          "  -k us     space skew in µsecs, default: 0\n"
+          "  -g rate   glitch probability per duration, default: 0\n"
+          "  -d rate   dropped edge probability per duration, default: 0\n"
+          "  -z count  average number of noise durations between frames, default: 0\n"
+          "  -w us     silence before every frame in µsecs, default: 0\n"
+          "  -f format output format: text, bin32 or capture, default: text\n"
+          "  -o file   stream output file, default: stdout\n"
+          "  -e file   expected frames output file\n");
+} // usage()
+
+
+int main(int argc, char *argv[])
+{
+  const char *protocols = nullptr;
+  const char *streamFile = nullptr;
+  const char *expectFile = nullptr;
+  const char *format = "text";
+  int count = 100;
+  unsigned long seed = 1;
+  SignalGenerator::Config config;
+  int opt;
+
+  while ((opt = getopt(argc, argv, "p:n:s:j:m:k:g:d:z:w:f:o:e:h")) != -1) {
+    if (opt == 'p') {
+      protocols = optarg;
+    } else if (opt == 'n') {
+      count = atoi(optarg);
+    } else if (opt == 's') {
+      seed = strtoul(optarg, nullptr, 0);
+    } else if (opt == 'j') {
+      config.jitter = atof(optarg);
+    } else if (opt == 'm') {
+      config.markSkew = atoi(optarg);
+    } else if (opt == 'k') {
+      config.spaceSkew = atoi(optarg);
+    } else if (opt == 'g') {
+      config.glitchRate = atof(optarg);
+    } else if (opt == 'd') {
+      config.dropRate = atof(optarg);
+    } else if (opt == 'z') {
+      config.noiseGap = atof(optarg);
+    } else if (opt == 'w') {
+      config.silence = strtoul(optarg, nullptr, 0);
+    } else if ((opt == 'f') && ((strcmp(optarg, "text") == 0) || (strcmp(optarg, "bin32") == 0) || (strcmp(optarg, "capture") == 0))) {
+      format = optarg;
+    } else if (opt == 'o') {
+      streamFile = optarg;
+    } else if (opt == 'e') {
+      expectFile = optarg;
+    } else {
+      usage();
+      return (2);
+    }
+  } // while
+
+  SignalParser::Protocol *list[32];
+  int protCount = ProtocolTable::select(protocols, list, 32);
+  if (protCount <= 0) {
+    fprintf(stderr, "rfgen: unknown protocol in '%s'\n", protocols);
+    return (2);
+  }
+
+  SignalGenerator gen(seed);
+  gen.setConfig(config);
+
+  std::mt19937 rnd(seed);
+  std::uniform_int_distribution<int> protocolIndex(0, protCount - 1);
+  for (int n = 0; n < count; n++) {
+    gen.addRandomFrames(list[protocolIndex(rnd)], 1);
+  }
+  gen.addNoise((int)config.noiseGap);
+
+  // write the stream
+  FILE *f = streamFile ? fopen(streamFile, "wb") : stdout;
+  if (!f) {
+    fprintf(stderr, "rfgen: cannot write '%s'\n", streamFile);
+    return (1);
+  }
+
+  bool binary = (strcmp(format, "bin32") == 0);
+  bool capture = (strcmp(format, "capture") == 0);
+  CaptureWriter writer;
+  if (capture) {
+    CaptureHeader header;
+    header.level = 0; // the stream starts with a low level gap.
+    streamOut = f;
+    writer.begin(header, writeCapture);
+  }
+
+  int len = 0;
+  for (SignalParser::CodeTime t : gen.stream()) {
+    if (capture) {
+      writer.write(t);
+    } else if (binary) {
+      unsigned char b[4] = {(unsigned char)t, (unsigned char)(t >> 8), (unsigned char)(t >> 16), (unsigned char)(t >> 24)};
+      fwrite(b, 1, 4, f);
+    } else {
+      fprintf(f, (len % 32 == 31) ? "%u,\n" : "%u,", t);
+      len++;
+    }
+  } // for
+  if (capture)
+    writer.flush();
+  if (!binary && !capture && (len % 32))
+    fputc('\n', f);
+  if (f != stdout)
+    fclose(f);
+
+  // write the expected frames
+  if (expectFile) {
+    f = fopen(expectFile, "w");
+    if (!f) {
+      fprintf(stderr, "rfgen: cannot write '%s'\n", expectFile);
+      return (1);
+    }
+    for (const SignalGenerator::Frame &frame : gen.frames()) {
+      fprintf(f, "%zu %llu [%s]\n", frame.offset, frame.time, frame.code.c_str());
+    }
+    fclose(f);
+  } // if
+
+  fprintf(stderr, "%zu durations, %zu frames\n", gen.stream().size(), gen.frames().size());
+  return (0);
+} // main()
+
+// End.
@@ -0,0 +1,239 @@
+/**
+ * @file rfroundtrip.cpp
+ *
+ * This file is part of the RFCodes library that implements receiving an sending
+ * RF and IR protocols.
+ *
+ * @copyright Copyright (c) by Matthias Hertel, https://www.mathertel.de.
+ *
+ * This work is licensed under a BSD 3-Clause style license,
+ * https://www.mathertel.de/License.aspx.
+ *
+ * @brief
+ * Round-trip property check: compose -> jitter -> parse for every protocol.
+ *
+ * For every protocol random valid code sequences are generated. They are
+ * composed by SignalParser::compose() or sent by SignalCollector::send() using
+ * the simulation backend, the timings are disturbed within the tolerance of the
+ * protocol and then parsed again. Every case must be decoded exactly.
+ * With -H the sequences are compiled into a handle by SignalParser::compile()
+ * first and the text of the handle must be the same as the sequence.
+ *
+ * The program returns 1 when a case failed so it can be used in automated
+ * builds.
+ *
+ * Changelog:
+ * * 16.10.2026 created.
+ * * 16.10.2026 drive the timer of the non-blocking send().
+ * * 16.10.2026 all copies are decoded with the gaps of the transmit queue.
+ * * 16.10.2026 compiled sequences.
+ * * 16.10.2026 exact size of the timings.
+ */
+
+#include <chrono>
+#include <random>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <unistd.h>
+#include <vector>
+
+#include "SignalCollector.h"
+#include "SignalHalSim.h"
+
+#include "ProtocolTable.h"
+#include "SignalGenerator.h"
+
+#define SEND_PIN 1
+
+static std::vector<std::string> decoded;
+static std::vector<SignalParser::CodeTime> sent;
+static bool sending = false;
+static unsigned long lastEdge = 0;
+
+static void receiveCode(const char *code)
+{
+  decoded.push_back(code);
+} // receiveCode()
+
+// collect the durations between the edges of the send pin.
+static void outputEdge(int pin, int, unsigned long now)
+{
+  if (pin == SEND_PIN) {
+    if (sending)
+      sent.push_back(now - lastEdge);
+    sending = true;
+    lastEdge = now;
+  }
+} // outputEdge()
+
+
+static void printTimings(const char *title, const std::vector<SignalParser::CodeTime> &timings)
+{
+  printf("  %s:", title);
+  for (size_t n = 0; n < timings.size(); n++) {
+    printf((n % 16 == 0) ? "\n    %u," : " %u,", timings[n]);
+  }
+  printf("\n");
+} // printTimings()
+
+
+static void usage()
+{
+  fprintf(stderr,
+          "usage: rfroundtrip [options]\n"
+          "  -p list   comma separated list of protocols, default: all\n"
+          "  -n count  cases per protocol, default: 10000\n"
+          "  -s seed   seed of the random generator, default: 1\n"
+          "  -m pct    maximal deviation in percent of the tolerance, default: 90\n"
+          "  -c        send by SignalCollector::send() instead of compose()\n"
+          "  -H        compile the sequences and use the handle\n"
+          "  -v        print all failed cases\n");
+} // usage()
+
+
+int main(int argc, char *argv[])
+{
+  const char *protocols = nullptr;
+  int count = 10000;
+  unsigned long seed = 1;
+  double margin = 90;
+  bool useSend = false;
+  bool useHandle = false;
+  bool verbose = false;
+  int opt;
+
+  while ((opt = getopt(argc, argv, "p:n:s:m:cHvh")) != -1) {
+    if (opt == 'p') {
+      protocols = optarg;
+    } else if (opt == 'n') {
+      count = atoi(optarg);
+    } else if (opt == 's') {
+      seed = strtoul(optarg, nullptr, 0);
+    } else if (opt == 'm') {
+      margin = atof(optarg);
+    } else if (opt == 'c') {
+      useSend = true;
+    } else if (opt == 'H') {
+      useHandle = true;
+    } else if (opt == 'v') {
+      verbose = true;
+    } else {
+      usage();
+      return (2);
+    }
+  } // while
+
+  SignalParser::Protocol *list[32];
+  int protCount = ProtocolTable::select(protocols, list, 32);
+  if (protCount <= 0) {
+    fprintf(stderr, "rfroundtrip: unknown protocol in '%s'\n", protocols);
+    return (2);
+  }
+
+  unsigned long totalFailed = 0;
+
+  for (int n = 0; n < protCount; n++) {
+    SignalParser::Protocol *p = list[n];
+    SignalParser sig;
+    SignalCollector col;
+    sig.load(p);
+    sig.attachCallback(receiveCode);
+
+    SignalHalSim::reset();
+    col.init(&sig, NO_PIN, SEND_PIN);
+    SignalHalSim::setOutputHook(outputEdge);
+
+    SignalGenerator gen(seed);
+    std::mt19937 rnd(seed);
+    std::uniform_real_distribution<double> deviation(-margin / 100 * p->tolerance / 100, margin / 100 * p->tolerance / 100);
+
+    unsigned long failed = 0;
+    auto start = std::chrono::steady_clock::now();
+
+    for (int c = 0; c < count; c++) {
+      std::string code = p->name;
+      code += ' ';
+      code += gen.randomCodes(p);
+
+      // get the timings
+      std::vector<SignalParser::CodeTime> timings;
+      int expected = 1;
+      bool compiled = true;
+      SignalParser::Handle handle;
+
+      if (useHandle) {
+        char text[PROTNAME_LEN + MAX_SEQUENCE_LENGTH];
+        compiled = (sig.compile(code.c_str(), &handle) >= 0);
+        SignalParser::getText(&handle, text, sizeof(text));
+        compiled = compiled && (code == text);
+      }
+
+      if (useSend) {
+        sent.clear();
+        sending = false;
+        if (useHandle)
+          col.send(&handle);
+        else
+          col.send(code.c_str());
+        while (col.isSending()) {
+          while (SignalHalSim::runTimer()) {
+            // the edges are written by the timer.
+          }
+          col.loop();
+        }
+        timings = sent;
+        // every copy is followed by a gap.
+        expected = p->sendRepeat;
+      } else {
+        // get the exact size first.
+        int len = useHandle ? SignalParser::compose(&handle, nullptr, 0) : sig.compose(code.c_str(), nullptr, 0);
+        timings.resize(len + 1);
+        if (useHandle)
+          SignalParser::compose(&handle, timings.data(), (int)timings.size());
+        else
+          sig.compose(code.c_str(), timings.data(), (int)timings.size());
+        compiled = compiled && (len >= 0) && (timings[len] == 0);
+        timings.resize(len);
+      }
+
+      // disturb within tolerance
+      std::vector<SignalParser::CodeTime> disturbed;
+      for (SignalParser::CodeTime t : timings) {
+        disturbed.push_back((SignalParser::CodeTime)(t * (1.0 + deviation(rnd))));
+      }
+
+      decoded.clear();
+      sig.reset();
+      for (SignalParser::CodeTime t : disturbed) {
+        sig.parse(t);
+      }
+
+      bool ok = compiled && ((int)decoded.size() >= expected) && (decoded.size() <= (size_t)p->sendRepeat);
+      for (const std::string &d : decoded) {
+        ok = ok && (d == code);
+      }
+
+      if (!ok) {
+        if ((failed == 0) || verbose) {
+          printf("FAILED %s: [%s]\n", p->name, code.c_str());
+          for (const std::string &d : decoded) {
+            printf("  decoded: [%s]\n", d.c_str());
+          }
+          printTimings("timings", timings);
+          printTimings("disturbed", disturbed);
+        }
+        failed++;
+      } // if
+    } // for
+
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    printf("%-4s %d cases, %lu failed, %.0f cases/sec\n", p->name, count, failed, count / seconds);
+    totalFailed += failed;
+  } // for
+
+  return (totalFailed ? 1 : 0);
+} // main()
+
+// End.
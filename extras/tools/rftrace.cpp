@@ -0,0 +1,245 @@
+/**
+ * @file rftrace.cpp
+ *
+ * This file is part of the RFCodes library that implements receiving an sending
+ * RF and IR protocols.
+ *
+ * @copyright Copyright (c) by Matthias Hertel, https://www.mathertel.de.
+ *
+ * This work is licensed under a BSD 3-Clause style license,
+ * https://www.mathertel.de/License.aspx.
+ *
+ * @brief
+ * Decoder for the binary trace records of the SignalParser, see SignalTrace.h.
+ *
+ * The records are read from the text output of SignalTrace::dump(), e.g. a
+ * serial monitor log, or from a binary file of 8 byte records and printed in
+ * a readable form. The protocol names are given in the order they were loaded
+ * into the parser.
+ *
+ * When the library is built with SIGNAL_TRACE a timing capture can be replayed
+ * by the parser to get the trace of the last records directly.
+ *
+ * Changelog:
+ * * 16.10.2026 created.
+ * * 16.10.2026 memory mapped input.
+ * * 16.10.2026 REJECT event.
+ */
+
+#include <ctype.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <vector>
+
+#include "SignalParser.h"
+#include "SignalTrace.h"
+
+#include "MappedFile.h"
+#include "ProtocolTable.h"
+#include "TimingReader.h"
+
+static const char *eventNames[] = {"?", "DURATION", "MATCH", "RETRY", "SYMBOL", "FRAGMENT", "FRAME", "RESET", "REJECT"};
+
+static SignalParser::Protocol *protocols[256];
+static int protocolCount = 0;
+
+
+static int hexValue(char c)
+{
+  if ((c >= '0') && (c <= '9'))
+    return (c - '0');
+  if ((c >= 'a') && (c <= 'f'))
+    return (c - 'a' + 10);
+  if ((c >= 'A') && (c <= 'F'))
+    return (c - 'A' + 10);
+  return (-1);
+} // hexValue()
+
+
+// parse all "T:" lines with 16 hex digits from the text output of dump().
+static void parseText(const char *data, size_t len, std::vector<SignalTrace::Record> &records)
+{
+  for (size_t pos = 0; pos + 18 <= len; pos++) {
+    if ((data[pos] != 'T') || (data[pos + 1] != ':') || ((pos > 0) && isalnum((unsigned char)data[pos - 1])))
+      continue;
+
+    unsigned char b[8];
+    bool ok = true;
+    for (int n = 0; ok && (n < 8); n++) {
+      int hi = hexValue(data[pos + 2 + 2 * n]);
+      int lo = hexValue(data[pos + 3 + 2 * n]);
+      ok = (hi >= 0) && (lo >= 0);
+      b[n] = (unsigned char)(hi << 4 | lo);
+    }
+
+    if (ok) {
+      SignalTrace::Record r;
+      r.event = b[0];
+      r.protocol = b[1];
+      r.code = (char)b[2];
+      r.count = b[3];
+      r.duration = (uint32_t)b[4] << 24 | (uint32_t)b[5] << 16 | (uint32_t)b[6] << 8 | b[7];
+      records.push_back(r);
+      pos += 17;
+    }
+  } // for
+} // parseText()
+
+
+// parse 8 byte records with a little endian duration.
+static void parseBinary(const char *data, size_t len, std::vector<SignalTrace::Record> &records)
+{
+  const unsigned char *b = (const unsigned char *)data;
+  for (size_t pos = 0; pos + 8 <= len; pos += 8, b += 8) {
+    SignalTrace::Record r;
+    r.event = b[0];
+    r.protocol = b[1];
+    r.code = (char)b[2];
+    r.count = b[3];
+    r.duration = (uint32_t)b[7] << 24 | (uint32_t)b[6] << 16 | (uint32_t)b[5] << 8 | b[4];
+    records.push_back(r);
+  }
+} // parseBinary()
+
+
+static void printRecords(const std::vector<SignalTrace::Record> &records)
+{
+  unsigned long durations = 0;
+
+  for (const SignalTrace::Record &r : records) {
+    const char *ev = (r.event < sizeof(eventNames) / sizeof(eventNames[0])) ? eventNames[r.event] : "?";
+
+    if (r.event == SignalTrace::DURATION) {
+      durations++;
+      printf("%6lu %6u\n", durations, r.duration);
+
+    } else {
+      char protname[8];
+      const char *name = protname;
+      if (r.protocol < protocolCount) {
+        name = protocols[r.protocol]->name;
+      } else {
+        snprintf(protname, sizeof(protname), "#%u", r.protocol);
+      }
+      char code = isprint((unsigned char)r.code) ? r.code : '-';
+      printf("       %-6s %-8s %c %3u\n", name, ev, code, r.count);
+    }
+  } // for
+} // printRecords()
+
+
+static void usage()
+{
+  fprintf(stderr,
+          "usage: rftrace [-p protocols] [-b] [file ...]\n"
+          "       rftrace [-p protocols] -r [-f format] [file ...]\n"
+          "  -p  comma separated list of protocols in the order of loading, default: all\n"
+          "  -b  read binary records instead of the text output of SignalTrace::dump()\n"
+          "  -r  replay timing captures through the parser and print the last records\n"
+          "  -f  input format of the captures: text, bin16, bin32 or capture, default: text\n"
+          "Reads from stdin when no file or '-' is given.\n");
+} // usage()
+
+
+int main(int argc, char *argv[])
+{
+  const char *list = nullptr;
+  bool binary = false;
+  bool replay = false;
+  TimingReader::Format format = TimingReader::TEXT;
+  int opt;
+
+  while ((opt = getopt(argc, argv, "p:brf:h")) != -1) {
+    if (opt == 'p') {
+      list = optarg;
+    } else if (opt == 'b') {
+      binary = true;
+    } else if (opt == 'r') {
+      replay = true;
+    } else if ((opt == 'f') && TimingReader::formatByName(optarg, &format)) {
+      // format is set
+    } else {
+      usage();
+      return (2);
+    }
+  } // while
+
+  protocolCount = ProtocolTable::select(list, protocols, 256);
+  if (protocolCount <= 0) {
+    fprintf(stderr, "rftrace: unknown protocol in '%s'\n", list);
+    return (2);
+  }
+
+#if !defined(SIGNAL_TRACE)
+  if (replay) {
+    fprintf(stderr, "rftrace: replay needs a library built with SIGNAL_TRACE (-DRFCODES_TRACE=ON)\n");
+    return (2);
+  }
+#endif
+
+  SignalParser sig;
+  for (int n = 0; n < protocolCount; n++) {
+    sig.load(protocols[n]);
+  }
+
+  static const char *stdinFiles[] = {"-"};
+  const char *const *files = argv + optind;
+  int fileCount = argc - optind;
+  if (fileCount == 0) {
+    files = stdinFiles;
+    fileCount = 1;
+  }
+
+  std::vector<SignalTrace::Record> records;
+  int ret = 0;
+
+  for (int n = 0; n < fileCount; n++) {
+    const char *fileName = files[n];
+    MappedFile file;
+
+    if (!file.open(fileName)) {
+      fprintf(stderr, "rftrace: cannot open '%s'\n", fileName);
+      ret = 1;
+      continue;
+    }
+    const char *data = file.data();
+    size_t len = file.size();
+
+    if (replay) {
+      TimingReader reader;
+      SignalParser::CodeTime buffer[1024];
+      int cnt;
+
+      if (!reader.begin(data, len, format)) {
+        fprintf(stderr, "rftrace: '%s' is not a capture file\n", fileName);
+        ret = 1;
+      }
+      while ((cnt = reader.read(buffer, 1024)) > 0) {
+        for (int i = 0; i < cnt; i++) {
+          sig.parse(buffer[i]);
+        }
+        file.release(reader.position());
+      }
+
+    } else if (binary) {
+      parseBinary(data, len, records);
+
+    } else {
+      parseText(data, len, records);
+    }
+  } // for
+
+  if (replay) {
+    records.resize(SIGNALTRACE_SIZE);
+    records.resize(SignalTrace::read(records.data(), SIGNALTRACE_SIZE));
+    fprintf(stderr, "%lu records written, showing the last %d\n",
+            (unsigned long)SignalTrace::written(), (int)records.size());
+  }
+
+  printRecords(records);
+  return (ret);
+} // main()
+
+// End.
@@ -14,9 +14,11 @@
  * Changelog:
  * * 29.04.2018 created by Matthias Hertel
  * * 06.08.2018 const char send, allow for sending only.
+ * * 16.10.2026 value records by the SignalDecoder.
  */
 
 #include <SignalCollector.h>
+#include <SignalDecoder.h>
 #include <SignalParser.h>
 
 #include <protocols.h>
@@ -0,0 +1,291 @@
+/**
+ * @file SignalCapture.cpp
+ *
+ * This file is part of the RFCodes library that implements receiving an sending
+ * RF and IR protocols.
+ *
+ * @copyright Copyright (c) by Matthias Hertel, https://www.mathertel.de.
+ *
+ * This work is licensed under a BSD 3-Clause style license,
+ * https://www.mathertel.de/License.aspx.
+ *
+ * @brief
+ * Compact binary capture format for timing streams with a writer and a reader.
+ *
+ * Change History see SignalCapture.h
+ */
+
+#include "SignalCapture.h"
+
+#include <string.h>
+
+#define CAPTURE_VERSION 1
+
+static const uint8_t _magic[4] = {'R', 'F', 'C', 'P'};
+
+
+// ===== little endian helpers =====
+
+static void _putLE(uint8_t *p, uint64_t value, int size)
+{
+  for (int n = 0; n < size; n++) {
+    *p++ = (uint8_t)value;
+    value >>= 8;
+  }
+} // _putLE()
+
+
+static uint64_t _getLE(const uint8_t *p, int size)
+{
+  uint64_t value = 0;
+  for (int n = size - 1; n >= 0; n--) {
+    value = (value << 8) | p[n];
+  }
+  return (value);
+} // _getLE()
+
+
+// ===== CaptureWriter =====
+
+void CaptureWriter::begin(const CaptureHeader &header, SinkFunction sink)
+{
+  uint8_t h[CAPTURE_HEADER_SIZE];
+
+  _sink = sink;
+  _syncInterval = header.syncInterval;
+  _count = 0;
+  _time = 0;
+  _len = 0;
+
+  memset(h, 0, sizeof(h));
+  memcpy(h, _magic, 4);
+  h[4] = CAPTURE_VERSION;
+  h[5] = header.level;
+  _putLE(h + 6, CAPTURE_HEADER_SIZE, 2);
+  _putLE(h + 8, header.resolution, 4);
+  _putLE(h + 12, header.receiverId, 4);
+  _putLE(h + 16, header.startTime, 8);
+  _putLE(h + 24, header.syncInterval, 4);
+  _put(h, sizeof(h));
+} // begin()
+
+
+void CaptureWriter::write(SignalParser::CodeTime duration)
+{
+  if (duration == 0)
+    return;
+
+  if (_syncInterval && (_count % _syncInterval == 0)) {
+    uint8_t m[CAPTURE_SYNC_SIZE];
+    m[0] = 0x00;
+    _putLE(m + 1, _count, 4);
+    _putLE(m + 5, _time, 8);
+    _put(m, sizeof(m));
+  }
+
+  uint8_t v[CAPTURE_MAX_VARINT];
+  size_t len = 0;
+  uint32_t value = duration;
+  while (value >= 0x80) {
+    v[len++] = (uint8_t)(value | 0x80);
+    value >>= 7;
+  }
+  v[len++] = (uint8_t)value;
+  _put(v, len);
+
+  _count++;
+  _time += duration;
+} // write()
+
+
+void CaptureWriter::flush()
+{
+  if (_sink && _len)
+    _sink(_buffer, _len);
+  _len = 0;
+} // flush()
+
+
+void CaptureWriter::_put(const uint8_t *data, size_t len)
+{
+  while (len) {
+    if (_len == sizeof(_buffer))
+      flush();
+    size_t n = sizeof(_buffer) - _len;
+    if (n > len)
+      n = len;
+    memcpy(_buffer + _len, data, n);
+    _len += n;
+    data += n;
+    len -= n;
+  }
+} // _put()
+
+
+// ===== CaptureReader =====
+
+bool CaptureReader::begin(const uint8_t *data, size_t len)
+{
+  _data = data;
+  _len = 0;
+  _start = _pos = 0;
+  _index = 0;
+  _time = 0;
+
+  if (!data || (len < CAPTURE_HEADER_SIZE) || (memcmp(data, _magic, 4) != 0) || (data[4] != CAPTURE_VERSION))
+    return (false);
+
+  size_t headerSize = (size_t)_getLE(data + 6, 2);
+  if ((headerSize < CAPTURE_HEADER_SIZE) || (headerSize > len))
+    return (false);
+
+  _header.level = data[5];
+  _header.resolution = (uint32_t)_getLE(data + 8, 4);
+  _header.receiverId = (uint32_t)_getLE(data + 12, 4);
+  _header.startTime = _getLE(data + 16, 8);
+  _header.syncInterval = (uint32_t)_getLE(data + 24, 4);
+
+  _len = len;
+  _start = _pos = headerSize;
+  return (true);
+} // begin()
+
+
+int CaptureReader::read(SignalParser::CodeTime *buffer, int len)
+{
+  int cnt = 0;
+
+  while ((cnt < len) && (_pos < _len)) {
+    if (_data[_pos] == 0x00) {
+      // sync marker, take over the position for resynchronization.
+      uint32_t index;
+      uint64_t time;
+      if (!_readSync(_pos, &index, &time))
+        break; // truncated
+      _index = index;
+      _time = time;
+      _pos += CAPTURE_SYNC_SIZE;
+      continue;
+    }
+
+    uint32_t value = 0;
+    int shift = 0;
+    size_t p = _pos;
+    while ((p < _len) && (_data[p] & 0x80) && (shift < 28)) {
+      value |= (uint32_t)(_data[p++] & 0x7F) << shift;
+      shift += 7;
+    }
+    if (p >= _len)
+      break; // truncated
+    value |= (uint32_t)_data[p++] << shift;
+    _pos = p;
+
+    buffer[cnt++] = (SignalParser::CodeTime)value;
+    _index++;
+    _time += value;
+  } // while
+  return (cnt);
+} // read()
+
+
+bool CaptureReader::seek(uint32_t index)
+{
+  if (!_data || !_len)
+    return (false);
+
+  // binary search for the last sync marker at or before the index.
+  size_t bestPos = _start;
+  uint32_t bestIndex = 0;
+  uint64_t bestTime = 0;
+  size_t lo = _start;
+  size_t hi = _len;
+
+  while (lo < hi) {
+    size_t mid = lo + (hi - lo) / 2;
+    size_t found;
+    uint32_t i;
+    uint64_t t;
+
+    if (!_findSync(mid, &found, &i, &t) || (found >= hi)) {
+      hi = mid;
+    } else if (i <= index) {
+      bestPos = found;
+      bestIndex = i;
+      bestTime = t;
+      lo = found + 1;
+    } else {
+      hi = mid;
+    }
+  } // while
+
+  _pos = bestPos;
+  _index = bestIndex;
+  _time = bestTime;
+
+  // decode the remaining durations.
+  SignalParser::CodeTime buffer[64];
+  while (_index < index) {
+    uint32_t n = index - _index;
+    if (n > 64)
+      n = 64;
+    if (read(buffer, (int)n) == 0)
+      return (false);
+  }
+
+  // step over a sync marker at the position.
+  if ((_pos < _len) && (_data[_pos] == 0x00)) {
+    uint32_t i;
+    uint64_t t;
+    if (_readSync(_pos, &i, &t) && (i == _index))
+      _pos += CAPTURE_SYNC_SIZE;
+  }
+  return (_pos < _len);
+} // seek()
+
+
+bool CaptureReader::_readSync(size_t pos, uint32_t *index, uint64_t *time)
+{
+  if ((pos + CAPTURE_SYNC_SIZE > _len) || (_data[pos] != 0x00))
+    return (false);
+  *index = (uint32_t)_getLE(_data + pos + 1, 4);
+  *time = _getLE(_data + pos + 5, 8);
+  return (true);
+} // _readSync()
+
+
+// find the next sync marker starting at pos.
+// A 0x00 byte may also be part of a marker, so a candidate is only taken when
+// the next marker follows after syncInterval durations or the data ends.
+bool CaptureReader::_findSync(size_t pos, size_t *found, uint32_t *index, uint64_t *time)
+{
+  uint32_t interval = _header.syncInterval;
+
+  while (interval && (pos < _len)) {
+    uint32_t i;
+    uint64_t t;
+
+    if ((_data[pos] == 0x00) && _readSync(pos, &i, &t) && (i % interval == 0) && (t >= i)) {
+      // skip the durations to the next marker.
+      size_t p = pos + CAPTURE_SYNC_SIZE;
+      uint32_t cnt = 0;
+      while ((cnt < interval) && (p < _len) && (_data[p] != 0x00)) {
+        if (!(_data[p] & 0x80))
+          cnt++;
+        p++;
+      }
+
+      uint32_t nextIndex;
+      uint64_t nextTime;
+      if ((p >= _len) || ((cnt == interval) && _readSync(p, &nextIndex, &nextTime) && (nextIndex == i + interval))) {
+        *found = pos;
+        *index = i;
+        *time = t;
+        return (true);
+      }
+    } // if
+    pos++;
+  } // while
+  return (false);
+} // _findSync()
+
+// End.
@@ -0,0 +1,171 @@
+/**
+ * @file: SignalCapture.h
+ *
+ * This file is part of the RFCodes library that implements receiving an sending
+ * RF and IR protocols.
+ *
+ * @copyright Copyright (c) by Matthias Hertel, https://www.mathertel.de.
+ *
+ * This work is licensed under a BSD 3-Clause style license,
+ * https://www.mathertel.de/License.aspx.
+ *
+ * @brief
+ * Compact binary capture format for timing streams with a writer and a reader.
+ *
+ * A capture starts with a header of 32 bytes, all values little endian:
+ *
+ * | offset | size | content                                          |
+ * | ------ | ---- | ------------------------------------------------ |
+ * | 0      | 4    | magic "RFCP"                                     |
+ * | 4      | 1    | version, currently 1                             |
+ * | 5      | 1    | level of the first duration: 0, 1 or 2=unknown   |
+ * | 6      | 2    | header size in bytes                             |
+ * | 8      | 4    | clock resolution in nsecs per tick, 1000 = µsecs |
+ * | 12     | 4    | receiver id                                      |
+ * | 16     | 8    | start timestamp in µsecs                         |
+ * | 24     | 4    | number of durations between sync markers         |
+ * | 28     | 4    | reserved, 0                                      |
+ *
+ * The durations follow as unsigned LEB128 varints: 7 bits per byte, the lowest
+ * bits first, the high bit is set in all bytes but the last one. Durations
+ * below 128 ticks use a single byte, below 16384 ticks 2 bytes.
+ *
+ * As durations are never 0 a 0x00 byte never starts a duration. It starts a
+ * sync marker of 13 bytes that is written before every syncInterval durations:
+ *
+ * | offset | size | content                                   |
+ * | ------ | ---- | ----------------------------------------- |
+ * | 0      | 1    | 0x00                                      |
+ * | 1      | 4    | number of durations before the marker     |
+ * | 5      | 8    | sum of the durations before the marker    |
+ *
+ * The markers allow seeking in long captures and finding the time of a
+ * duration without decoding the capture from the start.
+ *
+ * Changelog:
+ * * 16.10.2026 created.
+ */
+
+#ifndef SignalCapture_H_
+#define SignalCapture_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "SignalParser.h"
+
+#define CAPTURE_HEADER_SIZE 32
+#define CAPTURE_SYNC_SIZE 13
+#define CAPTURE_MAX_VARINT 5 // maximal size of a 32 bit varint
+
+#define CAPTURE_LEVEL_UNKNOWN 2
+
+// The settings of a capture stored in the header.
+struct CaptureHeader {
+  uint32_t resolution = 1000;   // clock resolution in nsecs per tick.
+  uint32_t receiverId = 0;      // id of the receiver or the device.
+  uint64_t startTime = 0;       // start timestamp in µsecs.
+  uint8_t level = CAPTURE_LEVEL_UNKNOWN; // level of the first duration.
+  uint32_t syncInterval = 1024; // number of durations between sync markers.
+};
+
+
+/** Writer of the capture format that passes the bytes to a sink function. */
+class CaptureWriter
+{
+public:
+  // Sink that gets the encoded bytes, e.g. to write them to a file or a serial port.
+  typedef void (*SinkFunction)(const uint8_t *data, size_t len);
+
+  /** start a new capture and write the header.
+   * @param header settings of the capture.
+   * @param sink the function that gets the encoded bytes.
+   */
+  void begin(const CaptureHeader &header, SinkFunction sink);
+
+  /** add a duration to the capture. Durations of 0 ticks are ignored. */
+  void write(SignalParser::CodeTime duration);
+
+  /** pass all buffered bytes to the sink. */
+  void flush();
+
+  /** number of durations written. */
+  uint32_t count()
+  {
+    return (_count);
+  };
+
+private:
+  SinkFunction _sink = nullptr;
+  uint32_t _syncInterval = 0;
+  uint32_t _count = 0;
+  uint64_t _time = 0;
+
+  uint8_t _buffer[64];
+  size_t _len = 0;
+
+  void _put(const uint8_t *data, size_t len);
+}; // class CaptureWriter
+
+
+/** Reader of the capture format from a memory buffer. */
+class CaptureReader
+{
+public:
+  /** start reading from a memory buffer that must stay valid while reading.
+   * @return true when the buffer starts with a valid header.
+   */
+  bool begin(const uint8_t *data, size_t len);
+
+  /** settings of the capture. */
+  const CaptureHeader &header()
+  {
+    return (_header);
+  };
+
+  /** read the next durations.
+   * @param buffer target buffer.
+   * @param len size of the buffer.
+   * @return number of durations in the buffer, 0 at the end of the data.
+   */
+  int read(SignalParser::CodeTime *buffer, int len);
+
+  /** set the read position to the duration with the given index using the sync markers.
+   * @return true when the index is inside the capture.
+   */
+  bool seek(uint32_t index);
+
+  /** index of the next duration. */
+  uint32_t index()
+  {
+    return (_index);
+  };
+
+  /** sum of the durations before the next duration in ticks. */
+  uint64_t time()
+  {
+    return (_time);
+  };
+
+  /** current read position in bytes. */
+  size_t position()
+  {
+    return (_pos);
+  };
+
+private:
+  CaptureHeader _header;
+  const uint8_t *_data = nullptr;
+  size_t _len = 0;
+  size_t _start = 0;
+  size_t _pos = 0;
+  uint32_t _index = 0;
+  uint64_t _time = 0;
+
+  bool _readSync(size_t pos, uint32_t *index, uint64_t *time);
+  bool _findSync(size_t pos, size_t *found, uint32_t *index, uint64_t *time);
+}; // class CaptureReader
+
+#endif // SignalCapture_H_
+
+// End.
@@ -11,6 +11,8 @@
  *
 */
 
+#include <string.h>
+
 #include "SignalCollector.h"
 
 // ====== SignalCollector implemenation =====
@@ -27,108 +29,97 @@ void SignalCollector::init(SignalParser *sig, int recvPin, int sendPin, int trim
   TRACE_MSG("Initalizing tabRF hardware\n");
 
   _sig = sig;
+#if defined(SIGNAL_LATENCY)
+  if (_sig)
+    _sig->attachFrameHook(_frameHook);
+#endif
 
   // Receiving mode
   _recvPin = recvPin;
   if (recvPin >= 0) {
     // initialize interrupt service routine
     // See https://www.arduino.cc/reference/en/language/functions/external-interrupts/attachinterrupt/
-    _irNumber = digitalPinToInterrupt(recvPin); // will return -1 on wrong pin number.
+    SignalHal::pinInput(_recvPin);
+    _irNumber = SignalHal::attachChange(_recvPin, signal_change_handler); // will return -1 on wrong pin number.
     if (_irNumber < 0) {
       TRACE_MSG("Error: Receiving pin cannot be used");
       _recvPin = -1;
-
-    } else {
-      pinMode(_recvPin, INPUT);
-      attachInterrupt(_irNumber, signal_change_handler, CHANGE);
     } // if
   }
 
   // Sending mode
   _sendPin = sendPin;
-  if (sendPin >= 0) {
-    // initialize sending mode
-    pinMode(_sendPin, OUTPUT);
-    digitalWrite(_sendPin, LOW);
-  }
+  _transmitter.init(sig, sendPin);
 } // init()
 
 
-void strcpyProtname(char *target, const char *signal)
+/** add a code to the transmit queue and return immediately. */
+bool SignalCollector::send(const char *signal)
 {
-  char *p = target;
-  char *s = (char *)signal;
-  int len = PROTNAME_LEN - 1;
-  while (len && *s && (*s != ' ')) {
-    *p++ = *s++;
-    len--;
-  }
-  *p = NUL;
-} // strcpyProtname
+  return (_transmitter.send(signal));
+} // send()
 
 
-void SignalCollector::send(const char *signal)
+/** add a compiled sequence to the transmit queue and return immediately. */
+bool SignalCollector::send(const SignalParser::Handle *handle)
 {
-  SignalParser::CodeTime timings[256];
-  int level = LOW; // LOW level before starting.
-  // INFO_MSG("send(%s)", signal);
-
-  char protname[PROTNAME_LEN];
-  strcpyProtname(protname, (char *)signal);
-  // INFO_MSG("send prot %s", protname);
-
-  int repeat = _sig->getSendRepeat(protname);
-  // INFO_MSG("send repeat %d", repeat);
-
-  if ((repeat) && (_sendPin >= 0)) {
-    // get timings of the code
-    _sig->compose(signal, timings, sizeof(timings) / sizeof(SignalParser::CodeTime));
-    // dumpTimings(timings);
-
-    while (repeat) {
-      SignalParser::CodeTime *t = timings;
-
-      if (_recvPin >= 0) {
-        noInterrupts();
-      }
-
-      while (*t) {
-        level = !level;
-        digitalWrite(_sendPin, level);
-        delayMicroseconds(*t++);
-      } // while
-
-      if (_recvPin >= 0) {
-        interrupts();
-      }
-
-      repeat--;
-    } // while
-    
-    // never leave active after sending.
-    digitalWrite(_sendPin, LOW);
-
-  } // if
+  return (_transmitter.send(handle));
 } // send()
 
 
 // process bytes from ring buffer
 void SignalCollector::loop()
 {
+  bool recorded = false;
+
+  _transmitter.loop();
+
   while (SignalCollector::buf88_cnt > 0) {
+#if defined(SIGNAL_LATENCY)
+    _parseEdge = SignalCollector::bufTime[SignalCollector::buf88_read - SignalCollector::buf88];
+    _addHistogram(&_residency, SignalHal::getMicros() - _parseEdge);
+#endif
     SignalParser::CodeTime t = *SignalCollector::buf88_read++;
     SignalCollector::buf88_cnt--;
 
-    _sig->parse(t);
+    if (_segmenter) {
+      _segmenter->parse(t);
+    } else {
+      _sig->parse(t);
+    }
+
+    if (_recorder) {
+      _recorder->write(t);
+      recorded = true;
+    }
 
     // reset pointer to the start when reaching end
     if (SignalCollector::buf88_read == SignalCollector::buf88_end)
       SignalCollector::buf88_read = SignalCollector::buf88;
-    yield();
+    SignalHal::yieldTask();
   } // while
+
+  if (recorded && _recorder)
+    _recorder->flush();
 } // loop
 
 
+/** Record all durations passed to the parser by loop(). */
+void SignalCollector::record(CaptureWriter *writer)
+{
+  if (_recorder)
+    _recorder->flush();
+  _recorder = writer;
+} // record()
+
+
+/** Pass the durations through a segmenter to the parser. */
+void SignalCollector::segment(SignalSegmenter *segmenter)
+{
+  _segmenter = segmenter;
+} // segment()
+
+
 // ===== Insights and Debugging Helpers =====
 
 
@@ -182,9 +173,15 @@ void SignalCollector::dumpTimings(SignalParser::CodeTime *raw)
 // This handler is attached to the change interrupt.
 void IRAM_ATTR SignalCollector::signal_change_handler()
 {
-  unsigned long now = micros();
+  unsigned long now = SignalHal::getMicros();
   SignalParser::CodeTime t = (SignalParser::CodeTime)(now - SignalCollector::lastTime);
 
+  if (SignalTransmitter::isActive()) {
+    // don't receive the own signal.
+    lastTime = now;
+    return;
+  }
+
   // // adjust the timing with the trim factor.
   // int level = digitalRead(_recvPin);
   // if (level) {
@@ -195,6 +192,9 @@ void IRAM_ATTR SignalCollector::signal_change_handler()
 
   // write to ring buffer
   if (SignalCollector::buf88_cnt < SC_BUFFERSIZE) {
+#if defined(SIGNAL_LATENCY)
+    SignalCollector::bufTime[SignalCollector::ringWrite - SignalCollector::buf88] = now;
+#endif
     *SignalCollector::ringWrite++ = t;
     buf88_cnt++;
 
@@ -203,15 +203,20 @@ void IRAM_ATTR SignalCollector::signal_change_handler()
       SignalCollector::ringWrite = SignalCollector::buf88;
   } // if
 
-  lastTime = now; // micros();
+  lastTime = now; // SignalHal::getMicros();
 } // signal_change_handler()
 
 
 // Inject a test timing into the ring buffer.
 void SignalCollector::injectTiming(SignalParser::CodeTime t)
 {
+  unsigned long now = SignalHal::getMicros();
+
   // write to ring buffer
   if (SignalCollector::buf88_cnt < SC_BUFFERSIZE) {
+#if defined(SIGNAL_LATENCY)
+    SignalCollector::bufTime[SignalCollector::ringWrite - SignalCollector::buf88] = now;
+#endif
     *SignalCollector::ringWrite++ = t;
     buf88_cnt++;
 
@@ -220,16 +225,77 @@ void SignalCollector::injectTiming(SignalParser::CodeTime t)
       SignalCollector::ringWrite = SignalCollector::buf88;
   } // if
 
-  SignalCollector::lastTime = micros();
+  SignalCollector::lastTime = now;
 } // injectTiming()
 
 
+// ===== Latency measurement =====
+
+void SignalCollector::_addHistogram(Histogram *h, unsigned long t)
+{
+  int n = 0;
+  while ((n < SC_HISTOGRAM_BUCKETS - 1) && (t >> (n + 1))) {
+    n++;
+  }
+  h->bucket[n]++;
+  h->count++;
+  h->sum += t;
+  if (t > h->max)
+    h->max = t;
+} // _addHistogram()
+
+
+// This hook is called by the parser before the callback of a sequence.
+void SignalCollector::_frameHook()
+{
+  _addHistogram(&_frameLatency, SignalHal::getMicros() - _parseEdge);
+} // _frameHook()
+
+
+/** Return the latency histograms. */
+void SignalCollector::getLatency(Histogram *frame, Histogram *residency)
+{
+  if (frame)
+    *frame = _frameLatency;
+  if (residency)
+    *residency = _residency;
+} // getLatency()
+
+
+// Clear the latency histograms.
+void SignalCollector::resetLatency()
+{
+  memset(&_frameLatency, 0, sizeof(Histogram));
+  memset(&_residency, 0, sizeof(Histogram));
+} // resetLatency()
+
+
+/** dump a histogram with the time range of the buckets. */
+void SignalCollector::dumpHistogram(const char *title, Histogram *h)
+{
+  RAW_MSG("%s: count:%lu avg:%lu max:%lu\n", title, h->count, h->count ? h->sum / h->count : 0, h->max);
+  for (int n = 0; n < SC_HISTOGRAM_BUCKETS; n++) {
+    if (h->bucket[n]) {
+      if (n < SC_HISTOGRAM_BUCKETS - 1) {
+        RAW_MSG("  %7lu - %7lu: %lu\n", n ? (1UL << n) : 0UL, (1UL << (n + 1)) - 1, h->bucket[n]);
+      } else {
+        RAW_MSG("  %7lu -        : %lu\n", 1UL << n, h->bucket[n]);
+      }
+    }
+  } // for
+} // dumpHistogram()
+
+
 int SignalCollector::_recvPin = -1;
 
 // allocate and initialize the static class members.
 
 unsigned long SignalCollector::lastTime = 0;
 
+unsigned long SignalCollector::_parseEdge = 0;
+SignalCollector::Histogram SignalCollector::_frameLatency;
+SignalCollector::Histogram SignalCollector::_residency;
+
 // allocate memory for ring buffer
 SignalParser::CodeTime *SignalCollector::buf88 = (SignalParser::CodeTime *)malloc(SC_BUFFERSIZE * sizeof(SignalParser::CodeTime));
 
@@ -244,4 +310,9 @@ SignalParser::CodeTime *SignalCollector::buf88_end = SignalCollector::buf88 + SC
 
 volatile unsigned int SignalCollector::buf88_cnt = 0; // number of bytes in buffer
 
+#if defined(SIGNAL_LATENCY)
+// edge times of the ring buffer
+unsigned long SignalCollector::bufTime[SC_BUFFERSIZE];
+#endif
+
 // End.
@@ -12,29 +12,57 @@
  * Changelog:
  * * 29.04.2018 created by Matthias Hertel
  * * 06.08.2018 const char send, allow for sending only.
+ * * 16.10.2026 use SignalHal functions to run on Arduino and host systems.
+ * * 16.10.2026 latency histograms.
+ * * 16.10.2026 record mode using the capture format.
+ * * 16.10.2026 optional segmentation stage before the parser.
+ * * 16.10.2026 non-blocking send() using the SignalTransmitter.
+ * * 16.10.2026 transmit queue.
+ * * 16.10.2026 send compiled sequences.
+ * * 16.10.2026 latency histograms only with SIGNAL_LATENCY.
  */
 
 #ifndef TabRF_H_
 #define TabRF_H_
 
-#include <Arduino.h>
+#include "SignalHal.h"
 
 #include "debugout.h"
+#include "SignalCapture.h"
 #include "SignalParser.h"
+#include "SignalSegmenter.h"
+#include "SignalTransmitter.h"
 
 #define NUL '\0'
 #define null 0
 
 #define NO_PIN (-1)
 
-#define TabRF_ERR(...) Serial.printf("Error: " __VA_ARGS__)
+#define TabRF_ERR(...) ERROR_MSG("Error: " __VA_ARGS__)
 
 #define SC_BUFFERSIZE 512
 
+// The latency histograms are measured only when SIGNAL_LATENCY is defined,
+// here or by the build flags. Otherwise no edge times are stored and the
+// histograms stay empty.
+// #define SIGNAL_LATENCY
+
+#define SC_HISTOGRAM_BUCKETS 16 // buckets of the latency histograms
+
 // main class for the TabRF library
 class SignalCollector
 {
 public:
+  // Histogram of times in µsecs.
+  // The bucket n counts the times from 2^n to 2^(n+1)-1 µsecs, bucket 0 also counts 0 µsecs.
+  // The last bucket counts all longer times.
+  struct Histogram {
+    unsigned long count; // number of measured times.
+    unsigned long sum;   // sum of all times, may wrap around.
+    unsigned long max;   // maximal time.
+    unsigned long bucket[SC_HISTOGRAM_BUCKETS];
+  };
+
   /**
    * @brief Initialize receiving and sending pins and register
    * interrupt service routine.
@@ -43,11 +71,49 @@ public:
    */
   void init(SignalParser *sig, int recvPin, int sendPin, int trim = 0);
 
-  // send out a new code
-  void send(const char *code);
+  /** add a code to the transmit queue and return immediately.
+   * Received edges are ignored while sending.
+   * @return true when the code was queued, false when the queue is full or the sequence is not valid, see SignalParser::compile().
+   */
+  bool send(const char *code);
+
+  /** add a sequence compiled by SignalParser::compile() to the transmit queue and return immediately.
+   * @return true when the sequence was queued, false when the queue is full or the handle is empty.
+   */
+  bool send(const SignalParser::Handle *handle);
+
+  /** return true until the end of sending all queued codes was reported by loop(). */
+  bool isSending()
+  {
+    return (_transmitter.isSending());
+  };
+
+  /** return the number of codes in the transmit queue. */
+  int getQueueDepth()
+  {
+    return (_transmitter.getQueueDepth());
+  };
+
+  /** attach a callback function that is called from loop() after sending. */
+  void attachSentCallback(SignalTransmitter::SentFunction newFunction)
+  {
+    _transmitter.attachSentCallback(newFunction);
+  };
 
   void loop();
 
+  /** Record all durations passed to the parser by loop().
+   * The writer must be started by CaptureWriter::begin() before.
+   * @param writer the capture writer or nullptr to stop recording.
+   */
+  void record(CaptureWriter *writer);
+
+  /** Pass the durations through a segmenter to the parser.
+   * The segmenter must be initialized by SignalSegmenter::init() with the same parser.
+   * @param segmenter the segmenter or nullptr to pass all durations to the parser.
+   */
+  void segment(SignalSegmenter *segmenter);
+
   // ===== Insights and Debugging Helpers =====
 
   // Return the number of buffered data in the ring buffer.
@@ -74,6 +140,18 @@ public:
   // Inject a test timing into the ring buffer.
   void injectTiming(SignalParser::CodeTime t);
 
+  /** Return the latency histograms, they are empty without SIGNAL_LATENCY.
+   * @param frame time from the final edge of a sequence until the callback function is called.
+   * @param residency time from an edge until its duration is taken from the ring buffer by loop().
+   */
+  void getLatency(Histogram *frame, Histogram *residency);
+
+  // Clear the latency histograms.
+  void resetLatency();
+
+  /** dump a histogram with the time range of the buckets. */
+  void dumpHistogram(const char *title, Histogram *h);
+
 
 private:
   // Ring buffer
@@ -84,10 +162,26 @@ private:
   static volatile SignalParser::CodeTime *buf88_read; // read pointer
   static SignalParser::CodeTime *buf88_end; // end of buffer+1 pointer for wrapping
   static volatile unsigned int buf88_cnt; // number of bytes in buffer
+#if defined(SIGNAL_LATENCY)
+  static unsigned long bufTime[SC_BUFFERSIZE]; // time of the edge for every duration in the ring buffer.
+#endif
 
   static unsigned long lastTime; // last time the interrupt was called.
 
+  // latency measurement
+  static unsigned long _parseEdge; // time of the edge of the duration being parsed.
+  static Histogram _frameLatency;
+  static Histogram _residency;
+
+  static void _addHistogram(Histogram *h, unsigned long t);
+
+  // This hook is called by the parser before the callback of a sequence.
+  static void _frameHook();
+
   SignalParser *_sig;
+  CaptureWriter *_recorder = nullptr;
+  SignalSegmenter *_segmenter = nullptr;
+  SignalTransmitter _transmitter;
 
 
   /** hardware related settings */
@@ -0,0 +1,340 @@
+/**
+ * @file SignalDecoder.cpp
+ *
+ * This file is part of the RFCodes library that implements receiving an sending
+ * RF and IR protocols.
+ *
+ * @copyright Copyright (c) by Matthias Hertel, https://www.mathertel.de.
+ *
+ * This work is licensed under a BSD 3-Clause style license,
+ * https://www.mathertel.de/License.aspx.
+ *
+ * @brief
+ * Registry of decoders that convert the received sequences of a protocol into
+ * value records.
+ *
+ * Change History see SignalDecoder.h
+ */
+
+#include <string.h>
+
+#include "SignalDecoder.h"
+
+#include "ircodes.h"
+#include "protocols.h"
+
+
+// get the bits of a sequence part using a code for 0 and a code for 1.
+static bool getBits(const char *seq, int bits, char zero, char one, unsigned long *value, bool lsbFirst = false)
+{
+  unsigned long v = 0;
+  for (int n = 0; n < bits; n++) {
+    int bit = lsbFirst ? n : bits - 1 - n;
+    if (seq[n] == one)
+      v |= (1UL << bit);
+    else if (seq[n] != zero)
+      return (false);
+  }
+  *value = v;
+  return (true);
+} // getBits()
+
+
+/** register a decode function for a protocol. */
+bool SignalDecoder::attach(const SignalParser::Protocol *protocol, DecodeFunction decodeFunc)
+{
+  for (int n = 0; n < _count; n++) {
+    if (_table[n].protocol == protocol) {
+      _table[n].decodeFunc = decodeFunc;
+      return (true);
+    }
+  } // for
+
+  if (!protocol || (_count >= SIGNALDECODER_SIZE))
+    return (false);
+  _table[_count].protocol = protocol;
+  _table[_count].decodeFunc = decodeFunc;
+  _count++;
+  return (true);
+} // attach()
+
+
+/** register the decode functions of the library. */
+void SignalDecoder::attachAll()
+{
+  attach(&RFCodes::it1, decodeIt1);
+  attach(&RFCodes::it2, decodeIt2);
+  attach(&RFCodes::sc5, decodeSc5);
+  attach(&RFCodes::cw, decodeCw);
+  attach(&IRCodes::nec, decodeNec);
+  attach(&IRCodes::rc5, decodeRc5);
+} // attachAll()
+
+
+/** attach a callback function that gets the decoded records. */
+void SignalDecoder::attachRecordCallback(RecordFunction newFunction)
+{
+  _recordFunc = newFunction;
+} // attachRecordCallback()
+
+
+/** set the rate of the reported nec repeat codes while a button is held. */
+void SignalDecoder::setNecRepeat(unsigned int delay, unsigned int interval)
+{
+  _repeatDelay = delay;
+  _repeatInterval = interval;
+} // setNecRepeat()
+
+
+/** decode a sequence and pass the record to the callback function. */
+bool SignalDecoder::decode(const SignalParser::Protocol *protocol, const char *seq, int len, unsigned long time)
+{
+  for (int n = 0; n < _count; n++) {
+    if ((_table[n].protocol == protocol) && _table[n].decodeFunc) {
+      Record record;
+      memset(&record, 0, sizeof(Record));
+      record.protocol = protocol;
+      record.time = time;
+
+      if (!_table[n].decodeFunc(seq, len, &record))
+        return (false);
+      if ((record.type == NEC) && !_holdNec(&record))
+        return (false);
+      if (_recordFunc)
+        _recordFunc(&record);
+      return (true);
+    } // if
+  } // for
+  return (false);
+} // decode()
+
+
+// it1: B + 10 DIP switches + '0' + on/off
+bool SignalDecoder::decodeIt1(const char *seq, int len, Record *record)
+{
+  unsigned long dips;
+
+  if ((len != 13) || (seq[0] != 'B') || !getBits(seq + 1, 10, '0', '1', &dips, true))
+    return (false);
+  if ((seq[12] != '0') && (seq[12] != '1'))
+    return (false);
+
+  record->type = IT1;
+  record->it1.dips = dips;
+  record->it1.on = (seq[12] == '0');
+  return (true);
+} // decodeIt1()
+
+
+// it2: s + 26 bit address + group + on/off or 'D' + 4 bit unit (+ 4 bit dim level) + x
+bool SignalDecoder::decodeIt2(const char *seq, int len, Record *record)
+{
+  unsigned long address, group, unit;
+  unsigned long dim = 0;
+  bool dimming = (len == 38);
+
+  if (((len != 34) && !dimming) || (seq[0] != 's') || (seq[len - 1] != 'x'))
+    return (false);
+  if (!getBits(seq + 1, 26, '_', '#', &address) || !getBits(seq + 27, 1, '_', '#', &group))
+    return (false);
+  if (!getBits(seq + 29, 4, '_', '#', &unit))
+    return (false);
+
+  if (dimming) {
+    if ((seq[28] != 'D') || !getBits(seq + 33, 4, '_', '#', &dim))
+      return (false);
+  } else if ((seq[28] != '_') && (seq[28] != '#')) {
+    return (false);
+  }
+
+  record->type = IT2;
+  record->it2.address = address;
+  record->it2.group = group;
+  record->it2.on = dimming || (seq[28] == '#');
+  record->it2.unit = unit;
+  record->it2.dim = dimming ? (int)dim : -1;
+  return (true);
+} // decodeIt2()
+
+
+// sc5: 12 tri-state pins + S
+bool SignalDecoder::decodeSc5(const char *seq, int len, Record *record)
+{
+  unsigned int high = 0;
+  unsigned int open = 0;
+
+  if ((len != 13) || (seq[12] != 'S'))
+    return (false);
+
+  for (int n = 0; n < 12; n++) {
+    if (seq[n] == '1')
+      high |= (1 << n);
+    else if (seq[n] == 'f')
+      open |= (1 << n);
+    else if (seq[n] != '0')
+      return (false);
+  }
+
+  record->type = SC5;
+  record->sc5.high = high;
+  record->sc5.open = open;
+  return (true);
+} // decodeSc5()
+
+
+// cw: the manchester bits of 7 bytes with the lowest bit first and a 0 bit between the bytes.
+// See /docs/cresta_protocol.md.
+bool SignalDecoder::decodeCw(const char *seq, int len, Record *record)
+{
+  uint8_t *data = record->cw.data;
+  int cnt = 0;
+
+  // simulate shifting in bits from header : 10101
+  uint8_t byte = 0x15;
+  int bits = 5;
+
+  if ((len < 1) || (seq[0] != 'H'))
+    return (false);
+
+  for (int n = 1; (n < len) && (cnt < 7); n++) {
+    if ((seq[n] != '0') && (seq[n] != '1'))
+      return (false);
+    int bit = seq[n] - '0';
+
+    if (bits < 8) {
+      // shift bit into data byte
+      byte |= bit << bits;
+      bits++;
+    } else {
+      // the bit between the bytes must be 0.
+      if (bit != 0)
+        return (false);
+      data[cnt++] = byte ^ (byte << 1); // decode
+      byte = 0;
+      bits = 0;
+    }
+  } // for
+
+  // the sensor sends more data bytes and the checksum that are not part of the sequence.
+  // The fixed first byte and the BCD digits are checked instead.
+  if ((cnt < 7) || (data[0] != 0x9f))
+    return (false);
+  if (((data[4] >> 4) > 9) || ((data[4] & 0x0f) > 9) || ((data[5] & 0x0f) > 9) || ((data[6] >> 4) > 9) || ((data[6] & 0x0f) > 9))
+    return (false);
+
+  record->type = CW;
+  record->cw.temperature = 100 * (data[5] & 0x0f) + 10 * (data[4] >> 4) + (data[4] & 0x0f);
+  record->cw.humidity = 10 * (data[6] >> 4) + (data[6] & 0x0f);
+  return (true);
+} // decodeCw()
+
+
+// nec: N + address + inverted address or extended address + command + inverted command, lowest bit first.
+// The repeat code R has no values, they are taken from the last command by decode().
+bool SignalDecoder::decodeNec(const char *seq, int len, Record *record)
+{
+  unsigned long address, command;
+
+  if ((len == 1) && (seq[0] == 'R')) {
+    record->type = NEC;
+    record->nec.repeat = 1;
+    return (true);
+  }
+
+  if ((len != 33) || (seq[0] != 'N'))
+    return (false);
+  if (!getBits(seq + 1, 16, '0', '1', &address, true) || !getBits(seq + 17, 16, '0', '1', &command, true))
+    return (false);
+
+  // the inverted command byte is the checksum.
+  if (((command ^ (command >> 8)) & 0xFF) != 0xFF)
+    return (false);
+
+  record->type = NEC;
+  record->nec.extended = (((address ^ (address >> 8)) & 0xFF) != 0xFF);
+  record->nec.address = record->nec.extended ? address : (address & 0xFF);
+  record->nec.command = command & 0xFF;
+  return (true);
+} // decodeNec()
+
+
+// rc5: S + second start bit + toggle bit + 5 address bits + 6 command bits, highest bit first.
+bool SignalDecoder::decodeRc5(const char *seq, int len, Record *record)
+{
+  unsigned long toggle, address, command;
+
+  if ((len != 14) || (seq[0] != 'S') || (seq[1] != '1'))
+    return (false);
+  if (!getBits(seq + 2, 1, '0', '1', &toggle) || !getBits(seq + 3, 5, '0', '1', &address) || !getBits(seq + 8, 6, '0', '1', &command))
+    return (false);
+
+  record->type = RC5;
+  record->rc5.address = address;
+  record->rc5.command = command;
+  record->rc5.toggle = toggle;
+  return (true);
+} // decodeRc5()
+
+
+/** check the fixed first byte and the 0 bits between the bytes of a cw sequence. */
+bool SignalDecoder::validateCw(const char *seq, int len)
+{
+  // the first byte 0x9f ends with the bits 110 after the header.
+  if ((len < 59) || (strncmp(seq, "H110", 4) != 0))
+    return (false);
+  for (int n = 4; n < 59; n += 9) {
+    if (seq[n] != '0')
+      return (false);
+  }
+  return (true);
+} // validateCw()
+
+
+/** check the inverted command byte of a nec sequence, a repeat code is always valid. */
+bool SignalDecoder::validateNec(const char *seq, int len)
+{
+  if ((len == 1) && (seq[0] == 'R'))
+    return (true);
+  if ((len != 33) || (seq[0] != 'N'))
+    return (false);
+  for (int n = 17; n < 25; n++) {
+    if (seq[n] == seq[n + 8])
+      return (false);
+  }
+  return (true);
+} // validateNec()
+
+
+// remember a nec command or complete a repeat code with the last command.
+// Returns false for stale repeat codes and the repeats that are skipped by the repeat rate.
+bool SignalDecoder::_holdNec(Record *record)
+{
+  unsigned long now = record->time;
+
+  if (record->nec.repeat == 0) {
+    // a new command
+    _nec = record->nec;
+    _necValid = true;
+    _necStart = _necLast = now;
+    _necNext = _repeatDelay;
+    return (true);
+  }
+
+  if (!_necValid || (now - _necLast > SIGNALDECODER_HOLD_TIMEOUT * 1000UL)) {
+    // the command is unknown or the button was released in between.
+    _necValid = false;
+    return (false);
+  }
+
+  _necLast = now;
+  _nec.repeat++;
+  _nec.held = (now - _necStart) / 1000;
+  record->nec = _nec;
+
+  if (_nec.held < _necNext)
+    return (false);
+  _necNext = _nec.held + _repeatInterval;
+  return (true);
+} // _holdNec()
+
+// End.
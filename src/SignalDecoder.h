@@ -0,0 +1,205 @@
+/**
+ * @file: SignalDecoder.h
+ *
+ * This file is part of the RFCodes library that implements receiving an sending
+ * RF and IR protocols.
+ *
+ * @copyright Copyright (c) by Matthias Hertel, https://www.mathertel.de.
+ *
+ * This work is licensed under a BSD 3-Clause style license,
+ * https://www.mathertel.de/License.aspx.
+ *
+ * @brief
+ * Registry of decoders that convert the received sequences of a protocol into
+ * value records.
+ *
+ * The parser passes every completed sequence to the decoder that is attached
+ * by SignalParser::attachDecoder(). The decode function registered for the
+ * protocol reads the codes directly from the sequence buffer of the protocol
+ * and fills a Record that is passed to the record callback function. Sequences
+ * that are not valid for the decode function are not reported.
+ *
+ * Decode functions for it1, it2, sc5, cw, nec and rc5 are part of the library
+ * and are registered by attachAll().
+ *
+ * The validate functions for cw and nec are set in the protocol definitions
+ * and drop invalid sequences in the parser, see SignalParser::attachValidator().
+ * They only compare the fixed bits and the inverted bytes in the sequence text
+ * without decoding the values.
+ *
+ * A nec remote sends a repeat code 'R' about every 108 msecs while a button is
+ * held. The decoder remembers the last nec command and reports the repeat
+ * codes as records of this command with a repeat counter and the time the
+ * button is held. Repeat codes that come later than SIGNALDECODER_HOLD_TIMEOUT
+ * after the last nec code are dropped. The times are taken from the parsed
+ * durations, see SignalParser::getTime(), so recorded streams age the same way. setNecRepeat() reduces the rate of the
+ * reported repeats like the auto-repeat of a keyboard.
+ *
+ * Changelog:
+ * * 16.10.2026 created.
+ * * 16.10.2026 validate functions.
+ * * 16.10.2026 nec repeat codes as held events.
+ * * 16.10.2026 cw manchester bits and rc5.
+ * * 16.10.2026 validate functions without decoding.
+ * * 16.10.2026 hold times from the time of the sequence.
+ */
+
+#ifndef SignalDecoder_H_
+#define SignalDecoder_H_
+
+#include <stdint.h>
+
+#include "SignalParser.h"
+
+#define SIGNALDECODER_SIZE 8 // maximal number of registered decoders
+
+#ifndef SIGNALDECODER_HOLD_TIMEOUT
+#define SIGNALDECODER_HOLD_TIMEOUT 150 // msecs after the last nec code until a repeat code is stale
+#endif
+
+class SignalDecoder
+{
+public:
+  // Types of the records.
+  typedef enum {
+    NONE = 0,
+    IT1,
+    IT2,
+    SC5,
+    CW,
+    NEC,
+    RC5
+  } RecordType;
+
+  // The settings of an it1 sender.
+  struct It1Value {
+    unsigned int dips; // 10 DIP switches, bit 0 is the first switch.
+    bool on;           // on or off command.
+  };
+
+  // An it2 on/off or dim command.
+  struct It2Value {
+    unsigned long address; // 26 bit id of the sender.
+    bool group;            // all receivers are addressed.
+    bool on;               // on or off command.
+    unsigned int unit;     // unit or button 0..15.
+    int dim;               // dim level 0..15 or -1 for an on/off command.
+  };
+
+  // The 12 tri-state pins of a sc5 sender.
+  struct Sc5Value {
+    unsigned int high; // pins sending '1', bit 0 is the first pin.
+    unsigned int open; // pins sending 'f'.
+  };
+
+  // The data of a cresta temperature and humidity sensor.
+  struct CwValue {
+    uint8_t data[7];  // the decoded data bytes.
+    int temperature;  // in 0.1 °C.
+    int humidity;     // in %.
+  };
+
+  // A nec infrared command.
+  struct NecValue {
+    unsigned int address; // 8 bit address or 16 bit extended address.
+    unsigned int command; // 8 bit command.
+    bool extended;        // the address was not sent with the inverted byte.
+    int repeat;           // 0 for a new command, number of repeat codes while the button is held.
+    unsigned long held;   // msecs since the command was received.
+  };
+
+  // A rc5 infrared command.
+  struct Rc5Value {
+    unsigned int address; // 5 bit address.
+    unsigned int command; // 6 bit command.
+    bool toggle;          // changes with every press of a button.
+  };
+
+  // A decoded sequence.
+  struct Record {
+    RecordType type;
+    const SignalParser::Protocol *protocol;
+    unsigned long time; // µsecs at the end of the sequence, see SignalParser::getTime().
+    union {
+      It1Value it1;
+      It2Value it2;
+      Sc5Value sc5;
+      CwValue cw;
+      NecValue nec;
+      Rc5Value rc5;
+    };
+  };
+
+  // Function that decodes the codes of a sequence without the protocol name.
+  typedef bool (*DecodeFunction)(const char *seq, int len, Record *record);
+
+  // Callback function that gets the decoded records.
+  typedef void (*RecordFunction)(const Record *record);
+
+  /** register a decode function for a protocol, a registered function is replaced.
+   * @return false when no more decoders can be registered.
+   */
+  bool attach(const SignalParser::Protocol *protocol, DecodeFunction decodeFunc);
+
+  /** register the decode functions of the library for it1, it2, sc5, cw, nec and rc5. */
+  void attachAll();
+
+  /** attach a callback function that gets the decoded records. */
+  void attachRecordCallback(RecordFunction newFunction);
+
+  /** set the rate of the reported nec repeat codes while a button is held.
+   * @param delay msecs after the command until the first repeat is reported.
+   * @param interval minimal msecs between the reported repeats, 0 reports every repeat code.
+   */
+  void setNecRepeat(unsigned int delay, unsigned int interval);
+
+  /** decode a sequence and pass the record to the callback function, used by the parser.
+   * @param time µsecs at the end of the sequence.
+   * @return true when the sequence was decoded.
+   */
+  bool decode(const SignalParser::Protocol *protocol, const char *seq, int len, unsigned long time);
+
+  // ===== decode functions of the library =====
+
+  static bool decodeIt1(const char *seq, int len, Record *record);
+  static bool decodeIt2(const char *seq, int len, Record *record);
+  static bool decodeSc5(const char *seq, int len, Record *record);
+  static bool decodeCw(const char *seq, int len, Record *record);
+  static bool decodeNec(const char *seq, int len, Record *record);
+  static bool decodeRc5(const char *seq, int len, Record *record);
+
+  // ===== validate functions of the library =====
+
+  /** check the fixed first byte and the 0 bits between the bytes of a cw sequence. */
+  static bool validateCw(const char *seq, int len);
+
+  /** check the inverted command byte of a nec sequence, a repeat code is always valid. */
+  static bool validateNec(const char *seq, int len);
+
+private:
+  struct Entry {
+    const SignalParser::Protocol *protocol;
+    DecodeFunction decodeFunc;
+  };
+
+  Entry _table[SIGNALDECODER_SIZE];
+  int _count = 0;
+
+  RecordFunction _recordFunc = nullptr;
+
+  // the last nec command for the repeat codes.
+  NecValue _nec;
+  bool _necValid = false;
+  unsigned long _necStart = 0;     // time of the command in µsecs.
+  unsigned long _necLast = 0;      // time of the last nec code in µsecs.
+  unsigned long _necNext = 0;      // held time in msecs for reporting the next repeat.
+  unsigned int _repeatDelay = 0;   // msecs until the first reported repeat.
+  unsigned int _repeatInterval = 0; // msecs between the reported repeats.
+
+  // remember a nec command or complete a repeat code.
+  bool _holdNec(Record *record);
+}; // class SignalDecoder
+
+#endif // SignalDecoder_H_
+
+// End.
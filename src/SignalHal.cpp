@@ -0,0 +1,127 @@
+/**
+ * @file SignalHal.cpp
+ *
+ * This file is part of the RFCodes library that implements receiving an sending
+ * RF and IR protocols.
+ *
+ * @copyright Copyright (c) by Matthias Hertel, https://www.mathertel.de.
+ *
+ * This work is licensed under a BSD 3-Clause style license,
+ * https://www.mathertel.de/License.aspx.
+ *
+ * @brief
+ * One-shot timer of the SignalHal on ESP8266 and ESP32 that does not need a
+ * hardware timer for its own.
+ *
+ * Change History see SignalHal.h
+ */
+
+#if defined(ARDUINO)
+
+#include "SignalHal.h"
+
+#if defined(ESP8266) && !defined(SIGNALHAL_TIMER1)
+
+#include <core_esp8266_waveform.h>
+
+#define SIGNALHAL_IDLE_TIME 100 // µsecs between the timer1 callbacks while not armed
+
+static SignalHal::IsrFunction _timerIsr = nullptr;
+static volatile bool _timerArmed = false;
+static volatile uint32_t _timerDue = 0; // cycle counter when the timer fires
+
+// Called by the waveform generator on every timer1 interrupt, also for other
+// waveforms, so the due time is checked by the cycle counter.
+// Returns the µsecs until the next call.
+static uint32_t IRAM_ATTR _timerCallback()
+{
+  if (_timerArmed && ((int32_t)(_timerDue - ESP.getCycleCount()) <= 0)) {
+    _timerArmed = false;
+    if (_timerIsr)
+      _timerIsr(); // may arm the timer again
+  }
+
+  if (_timerArmed) {
+    int32_t wait = (int32_t)(_timerDue - ESP.getCycleCount());
+    if (wait > 0)
+      return (clockCyclesToMicroseconds(wait) + 1);
+    return (1);
+  }
+  return (SIGNALHAL_IDLE_TIME);
+} // _timerCallback()
+
+
+bool SignalHal::attachTimer(IsrFunction isr)
+{
+  _timerArmed = false;
+  _timerIsr = isr;
+  setTimer1Callback(_timerCallback);
+  return (true);
+} // attachTimer()
+
+
+void IRAM_ATTR SignalHal::armTimer(unsigned long us)
+{
+  _timerDue = ESP.getCycleCount() + microsecondsToClockCycles(us);
+  _timerArmed = true;
+} // armTimer()
+
+
+void SignalHal::detachTimer()
+{
+  _timerArmed = false;
+  setTimer1Callback(nullptr);
+  _timerIsr = nullptr;
+} // detachTimer()
+
+
+#elif defined(ESP32)
+
+#include <esp_timer.h>
+
+static SignalHal::IsrFunction _timerIsr = nullptr;
+static esp_timer_handle_t _timer = nullptr;
+
+// Called by the esp_timer task when the timer fires.
+static void _timerCallback(void *)
+{
+  if (_timerIsr)
+    _timerIsr();
+} // _timerCallback()
+
+
+bool SignalHal::attachTimer(IsrFunction isr)
+{
+  if (!_timer) {
+    esp_timer_create_args_t args = {};
+    args.callback = _timerCallback;
+    args.name = "rfcodes";
+    if (esp_timer_create(&args, &_timer) != ESP_OK) {
+      _timer = nullptr;
+      return (false);
+    }
+  }
+  esp_timer_stop(_timer);
+  _timerIsr = isr;
+  return (true);
+} // attachTimer()
+
+
+void IRAM_ATTR SignalHal::armTimer(unsigned long us)
+{
+  esp_timer_start_once(_timer, us);
+} // armTimer()
+
+
+void SignalHal::detachTimer()
+{
+  if (_timer)
+    esp_timer_stop(_timer);
+  _timerIsr = nullptr;
+} // detachTimer()
+
+#endif
+
+#endif // ARDUINO
+
+// End.
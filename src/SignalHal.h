@@ -0,0 +1,232 @@
+/**
+ * @file: SignalHal.h
+ *
+ * This file is part of the RFCodes library that implements receiving an sending
+ * RF and IR protocols.
+ *
+ * @copyright Copyright (c) by Matthias Hertel, https://www.mathertel.de.
+ *
+ * This work is licensed under a BSD 3-Clause style license,
+ * https://www.mathertel.de/License.aspx.
+ *
+ * @brief
+ * Hardware abstraction for the SignalCollector: clock, pin I/O, change
+ * interrupts, a one-shot timer and critical sections.
+ *
+ * The backend is selected at compile time:
+ * * On Arduino the functions are thin inline wrappers of the Arduino API so
+ *   they can be used from interrupt service routines.
+ * * On all other platforms the simulation backend in SignalHalSim.cpp is used.
+ *   It provides a virtual clock and a scripted edge source, see SignalHalSim.h.
+ *
+ * The function names differ from the Arduino API on purpose as some of the
+ * Arduino functions like noInterrupts() are implemented as macros.
+ *
+ * The one-shot timer is implemented in SignalHal.cpp:
+ * * On ESP8266 it shares timer1 with the waveform generator of the core by
+ *   setTimer1Callback(), so analogWrite(), tone() and the Servo library can be
+ *   used while sending.
+ * * On ESP8266 with SIGNALHAL_TIMER1 defined as a compiler flag, e.g. in the
+ *   build_flags of PlatformIO, timer1 is used exclusively for the best timing.
+ *   analogWrite(), tone() and the Servo library cannot be used with this option.
+ * * On ESP32 a one-shot esp_timer is used.
+ * * Other boards like AVR have no timer backend, attachTimer() returns false
+ *   and the transmitter sends every copy blocking.
+ *
+ * Changelog:
+ * * 16.10.2026 created.
+ * * 16.10.2026 one-shot timer for sending.
+ * * 16.10.2026 timer1 only with SIGNALHAL_TIMER1.
+ * * 16.10.2026 shared timer1 on ESP8266 and esp_timer on ESP32 by default.
+ */
+
+#ifndef SignalHal_H_
+#define SignalHal_H_
+
+#if defined(ARDUINO)
+#include <Arduino.h>
+
+#define SIGNALHAL_INLINE inline __attribute__((always_inline))
+
+#else
+#include <stdint.h>
+#include <stdlib.h>
+
+// functions used in interrupt service routines need no special placement.
+#ifndef IRAM_ATTR
+#define IRAM_ATTR
+#endif
+
+#ifndef LOW
+#define LOW 0x0
+#endif
+
+#ifndef HIGH
+#define HIGH 0x1
+#endif
+
+#endif
+
+
+/** namespace for the hardware functions used by the RFCodes library. */
+namespace SignalHal
+{
+
+// Function type for interrupt service routines and timer callbacks.
+typedef void (*IsrFunction)();
+
+#if defined(ARDUINO)
+
+/** return the current time in µsecs. */
+SIGNALHAL_INLINE unsigned long getMicros()
+{
+  return (micros());
+}
+
+/** busy wait for the given time in µsecs. */
+SIGNALHAL_INLINE void delayMicros(unsigned int us)
+{
+  delayMicroseconds(us);
+}
+
+/** configure the pin for input. */
+SIGNALHAL_INLINE void pinInput(int pin)
+{
+  pinMode(pin, INPUT);
+}
+
+/** configure the pin for output. */
+SIGNALHAL_INLINE void pinOutput(int pin)
+{
+  pinMode(pin, OUTPUT);
+}
+
+/** set the output level of the pin. */
+SIGNALHAL_INLINE void writePin(int pin, int level)
+{
+  digitalWrite(pin, level);
+}
+
+/** get the input level of the pin. */
+SIGNALHAL_INLINE int readPin(int pin)
+{
+  return (digitalRead(pin));
+}
+
+/** attach the isr to any level change of the pin.
+ * @return the interrupt number or -1 when the pin cannot be used.
+ */
+SIGNALHAL_INLINE int attachChange(int pin, IsrFunction isr)
+{
+  int irNumber = digitalPinToInterrupt(pin); // will return -1 on wrong pin number.
+  if (irNumber >= 0) {
+    attachInterrupt(irNumber, isr, CHANGE);
+  }
+  return (irNumber);
+}
+
+/** detach the isr from the interrupt number returned by attachChange(). */
+SIGNALHAL_INLINE void detachChange(int irNumber)
+{
+  detachInterrupt(irNumber);
+}
+
+#if defined(ESP8266) && defined(SIGNALHAL_TIMER1)
+
+/** attach the isr to the one-shot timer.
+ * @return true when a timer is available.
+ */
+SIGNALHAL_INLINE bool attachTimer(IsrFunction isr)
+{
+  timer1_attachInterrupt(isr);
+  timer1_enable(TIM_DIV16, TIM_EDGE, TIM_SINGLE);
+  return (true);
+}
+
+/** start the timer to call the isr once after the given time in µsecs. */
+SIGNALHAL_INLINE void armTimer(unsigned long us)
+{
+  timer1_write(us * 5); // 80 MHz / 16 = 5 ticks per µsec
+}
+
+/** stop the timer and detach the isr. */
+SIGNALHAL_INLINE void detachTimer()
+{
+  timer1_disable();
+  timer1_detachInterrupt();
+}
+
+#elif defined(ESP8266) || defined(ESP32)
+
+// The timer functions are implemented in SignalHal.cpp.
+
+/** attach the isr to the one-shot timer.
+ * @return true when a timer is available.
+ */
+bool attachTimer(IsrFunction isr);
+
+/** start the timer to call the isr once after the given time in µsecs. */
+void IRAM_ATTR armTimer(unsigned long us);
+
+/** stop the timer and detach the isr. */
+void detachTimer();
+
+#else
+
+// no timer, the transmitter sends blocking.
+
+SIGNALHAL_INLINE bool attachTimer(IsrFunction)
+{
+  return (false);
+}
+
+SIGNALHAL_INLINE void armTimer(unsigned long) {}
+
+SIGNALHAL_INLINE void detachTimer() {}
+
+#endif
+
+/** start a critical section. */
+SIGNALHAL_INLINE void disableInterrupts()
+{
+  noInterrupts();
+}
+
+/** end a critical section. */
+SIGNALHAL_INLINE void enableInterrupts()
+{
+  interrupts();
+}
+
+/** give other tasks like WiFi some time. */
+SIGNALHAL_INLINE void yieldTask()
+{
+  yield();
+}
+
+#else
+
+// The simulation backend implements these functions in SignalHalSim.cpp.
+
+unsigned long getMicros();
+void delayMicros(unsigned int us);
+void pinInput(int pin);
+void pinOutput(int pin);
+void writePin(int pin, int level);
+int readPin(int pin);
+int attachChange(int pin, IsrFunction isr);
+void detachChange(int irNumber);
+bool attachTimer(IsrFunction isr);
+void armTimer(unsigned long us);
+void detachTimer();
+void disableInterrupts();
+void enableInterrupts();
+void yieldTask();
+
+#endif
+
+} // namespace SignalHal
+
+#endif // SignalHal_H_
+
+// End.
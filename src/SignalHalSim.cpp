@@ -0,0 +1,308 @@
+/**
+ * @file SignalHalSim.cpp
+ *
+ * This file is part of the RFCodes library that implements receiving an sending
+ * RF and IR protocols.
+ *
+ * @copyright Copyright (c) by Matthias Hertel, https://www.mathertel.de.
+ *
+ * This work is licensed under a BSD 3-Clause style license,
+ * https://www.mathertel.de/License.aspx.
+ *
+ * @brief
+ * Simulation backend of the SignalHal functions using a virtual clock and a
+ * scripted edge source.
+ *
+ * Change History see SignalHalSim.h
+ */
+
+#if !defined(ARDUINO)
+
+#include "SignalHalSim.h"
+
+#include <string.h>
+
+
+// ===== simulation state =====
+
+static unsigned long _now = 0; // virtual clock in µsecs
+
+static int _level[SIMHAL_PINS];                     // current level of all pins
+static SignalHal::IsrFunction _isr[SIMHAL_PINS];    // attached change handlers
+static int _edgePin = -1;                           // pin driven by the edge script
+static int _irqDisabled = 0;                        // critical section nesting
+static bool _irqPending = false;                    // edge deferred while interrupts are disabled
+
+static bool _timerAvailable = true;                 // attachTimer() succeeds
+static SignalHal::IsrFunction _timerIsr = nullptr; // attached timer handler
+static bool _timerArmed = false;
+static unsigned long _timerDue = 0;                 // time when the timer fires
+static bool _timerPending = false;                  // timer deferred while interrupts are disabled
+
+static unsigned int *_script = nullptr; // scripted durations
+static int _scriptAlloc = 0;
+static int _scriptCount = 0;
+static int _scriptPos = 0;
+
+static SignalHalSim::OutputFunction _outputHook = nullptr;
+
+
+static bool _validPin(int pin)
+{
+  return ((pin >= 0) && (pin < SIMHAL_PINS));
+} // _validPin()
+
+
+// fire the armed timer at its time.
+static void _fireTimer()
+{
+  _now = _timerDue;
+  _timerArmed = false;
+  if (_irqDisabled) {
+    _timerPending = true;
+  } else if (_timerIsr) {
+    _timerIsr();
+  }
+} // _fireTimer()
+
+
+// advance the clock and fire the timer on the way.
+static void _advance(unsigned long us)
+{
+  unsigned long end = _now + us;
+  while (_timerArmed && ((long)(end - _timerDue) >= 0)) {
+    _fireTimer();
+  }
+  _now = end;
+} // _advance()
+
+
+// ===== SignalHal functions =====
+
+unsigned long SignalHal::getMicros()
+{
+  return (_now);
+} // getMicros()
+
+
+void SignalHal::delayMicros(unsigned int us)
+{
+  _advance(us);
+} // delayMicros()
+
+
+void SignalHal::pinInput(int pin)
+{
+  if (_validPin(pin))
+    _level[pin] = LOW;
+} // pinInput()
+
+
+void SignalHal::pinOutput(int pin)
+{
+  if (_validPin(pin))
+    _level[pin] = LOW;
+} // pinOutput()
+
+
+void SignalHal::writePin(int pin, int level)
+{
+  if (_validPin(pin)) {
+    level = level ? HIGH : LOW;
+    if (_level[pin] != level) {
+      _level[pin] = level;
+      if (_outputHook)
+        _outputHook(pin, level, _now);
+    }
+  } // if
+} // writePin()
+
+
+int SignalHal::readPin(int pin)
+{
+  return (_validPin(pin) ? _level[pin] : LOW);
+} // readPin()
+
+
+int SignalHal::attachChange(int pin, IsrFunction isr)
+{
+  if (!_validPin(pin))
+    return (-1);
+
+  _isr[pin] = isr;
+  _edgePin = pin;
+  return (pin);
+} // attachChange()
+
+
+void SignalHal::detachChange(int irNumber)
+{
+  if (_validPin(irNumber)) {
+    _isr[irNumber] = nullptr;
+    if (_edgePin == irNumber)
+      _edgePin = -1;
+  }
+} // detachChange()
+
+
+bool SignalHal::attachTimer(IsrFunction isr)
+{
+  if (!_timerAvailable)
+    return (false);
+  _timerIsr = isr;
+  _timerArmed = false;
+  _timerPending = false;
+  return (true);
+} // attachTimer()
+
+
+void SignalHal::armTimer(unsigned long us)
+{
+  _timerDue = _now + us;
+  _timerArmed = true;
+} // armTimer()
+
+
+void SignalHal::detachTimer()
+{
+  _timerIsr = nullptr;
+  _timerArmed = false;
+  _timerPending = false;
+} // detachTimer()
+
+
+void SignalHal::disableInterrupts()
+{
+  _irqDisabled++;
+} // disableInterrupts()
+
+
+void SignalHal::enableInterrupts()
+{
+  if (_irqDisabled > 0)
+    _irqDisabled--;
+
+  if ((_irqDisabled == 0) && _irqPending) {
+    // a change interrupt was raised while disabled.
+    _irqPending = false;
+    if ((_edgePin >= 0) && _isr[_edgePin])
+      _isr[_edgePin]();
+  }
+
+  if ((_irqDisabled == 0) && _timerPending) {
+    // the timer fired while disabled.
+    _timerPending = false;
+    if (_timerIsr)
+      _timerIsr();
+  }
+} // enableInterrupts()
+
+
+void SignalHal::yieldTask()
+{
+  // nothing to do in the simulation.
+} // yieldTask()
+
+
+// ===== simulation control =====
+
+void SignalHalSim::reset()
+{
+  _now = 0;
+  memset(_level, 0, sizeof(_level));
+  memset(_isr, 0, sizeof(_isr));
+  _edgePin = -1;
+  _irqDisabled = 0;
+  _irqPending = false;
+  _timerAvailable = true;
+  _timerIsr = nullptr;
+  _timerArmed = false;
+  _timerPending = false;
+  _scriptCount = 0;
+  _scriptPos = 0;
+  _outputHook = nullptr;
+} // reset()
+
+
+void SignalHalSim::setTimer(bool available)
+{
+  _timerAvailable = available;
+} // setTimer()
+
+
+unsigned long SignalHalSim::now()
+{
+  return (_now);
+} // now()
+
+
+void SignalHalSim::advance(unsigned long us)
+{
+  _advance(us);
+} // advance()
+
+
+void SignalHalSim::script(const unsigned int *durations, int count)
+{
+  if (durations && (count > 0)) {
+    // drop already delivered edges before growing.
+    if (_scriptPos > 0) {
+      memmove(_script, _script + _scriptPos, (_scriptCount - _scriptPos) * sizeof(unsigned int));
+      _scriptCount -= _scriptPos;
+      _scriptPos = 0;
+    }
+
+    if (_scriptCount + count > _scriptAlloc) {
+      _scriptAlloc = _scriptCount + count + 256;
+      _script = (unsigned int *)realloc(_script, _scriptAlloc * sizeof(unsigned int));
+    }
+    memcpy(_script + _scriptCount, durations, count * sizeof(unsigned int));
+    _scriptCount += count;
+  } // if
+} // script()
+
+
+int SignalHalSim::pending()
+{
+  return (_scriptCount - _scriptPos);
+} // pending()
+
+
+bool SignalHalSim::step()
+{
+  if (_scriptPos >= _scriptCount)
+    return (false);
+
+  _advance(_script[_scriptPos++]);
+
+  if (_edgePin >= 0) {
+    _level[_edgePin] = !_level[_edgePin];
+
+    if (_irqDisabled) {
+      _irqPending = true;
+    } else if (_isr[_edgePin]) {
+      _isr[_edgePin]();
+    }
+  } // if
+  return (true);
+} // step()
+
+
+bool SignalHalSim::runTimer()
+{
+  if (!_timerArmed)
+    return (false);
+
+  _fireTimer();
+  return (true);
+} // runTimer()
+
+
+void SignalHalSim::setOutputHook(OutputFunction hook)
+{
+  _outputHook = hook;
+} // setOutputHook()
+
+#endif // !ARDUINO
+
+// End.
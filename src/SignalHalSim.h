@@ -0,0 +1,99 @@
+/**
+ * @file: SignalHalSim.h
+ *
+ * This file is part of the RFCodes library that implements receiving an sending
+ * RF and IR protocols.
+ *
+ * @copyright Copyright (c) by Matthias Hertel, https://www.mathertel.de.
+ *
+ * This work is licensed under a BSD 3-Clause style license,
+ * https://www.mathertel.de/License.aspx.
+ *
+ * @brief
+ * Simulation backend of the SignalHal functions for building and running the
+ * library on Linux and other host systems.
+ *
+ * The simulation uses a virtual clock that only advances by delayMicros() or
+ * when the scripted edge source delivers an edge. This makes runs repeatable
+ * and independent of the speed of the host. The one-shot timer fires when the
+ * clock passes its time.
+ *
+ * A typical host program scripts some timings, runs them through the interrupt
+ * service routine of the SignalCollector and lets the collector parse them:
+ *
+ * ```CPP
+ * col.init(&sig, 5, NO_PIN);
+ * SignalHalSim::script(timings, count);
+ * while (SignalHalSim::step()) {
+ *   col.loop();
+ * }
+ * col.loop();
+ * ```
+ *
+ * Changelog:
+ * * 16.10.2026 created.
+ * * 16.10.2026 one-shot timer.
+ * * 16.10.2026 boards without a timer.
+ */
+
+#ifndef SignalHalSim_H_
+#define SignalHalSim_H_
+
+#if !defined(ARDUINO)
+
+#include "SignalHal.h"
+
+#define SIMHAL_PINS 64 // number of simulated pins
+
+/** namespace for controlling the simulation backend. */
+namespace SignalHalSim
+{
+
+// Callback when a simulated output pin changes its level.
+typedef void (*OutputFunction)(int pin, int level, unsigned long now);
+
+/** reset the clock, all pins, interrupts and the edge script. */
+void reset();
+
+/** simulate a board without a timer, attachTimer() returns false. reset() makes it available again. */
+void setTimer(bool available);
+
+/** get the current virtual time in µsecs. */
+unsigned long now();
+
+/** advance the virtual clock. */
+void advance(unsigned long us);
+
+/** append durations to the scripted edge source.
+ * Each duration is the time from the previous edge to the next edge.
+ * @param durations list of durations in µsecs.
+ * @param count number of durations.
+ */
+void script(const unsigned int *durations, int count);
+
+/** number of scripted edges that are not yet delivered. */
+int pending();
+
+/** deliver the next scripted edge by advancing the clock, toggling the input
+ * level and calling the attached interrupt service routine.
+ * When interrupts are disabled the call is deferred until they are enabled again.
+ * @return true when an edge was delivered.
+ */
+bool step();
+
+/** advance the clock to the time of the armed timer and call its isr.
+ * When interrupts are disabled the call is deferred until they are enabled again.
+ * @return true when the timer was armed.
+ */
+bool runTimer();
+
+/** register a function that is called on every level change of an output pin. */
+void setOutputHook(OutputFunction hook);
+
+} // namespace SignalHalSim
+
+#endif // !ARDUINO
+
+#endif // SignalHalSim_H_
+
+// End.
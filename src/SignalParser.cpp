@@ -16,25 +16,27 @@
  * Change History see SignalParser.h
  */
 
-#include <Arduino.h>
+#include <stdlib.h>
+#include <string.h>
 
 #include "SignalParser.h"
 
+#include "SignalDecoder.h"
+#include "SignalHal.h" // for IRAM_ATTR
+
 
 // ===== private functions =====
 
 
 /** find protocol by name */
-SignalParser::Protocol *SignalParser::_findProt(char *name)
+SignalParser::Protocol *SignalParser::_findProt(const char *name)
 {
-  Protocol *p = nullptr;
-
   for (int n = 0; n < _protocolCount; n++) {
-    p = _protocol[n];
+    Protocol *p = _protocol[n];
     if (strcmp(name, p->name) == 0)
-      break;
+      return (p);
   }
-  return (p);
+  return (nullptr);
 } // _findProt()
 
 
@@ -54,6 +56,34 @@ SignalParser::Code *SignalParser::_findCode(Protocol *p, char codeName)
 } // _findCode()
 
 
+/** find the index of a code by name, the bits of the manchester mode are BIT0 and BIT1.
+ * @return the index or -1 when the code is not defined.
+ */
+static int codeIndex(const SignalParser::Protocol *p, char codeName)
+{
+  for (int n = 0; (n < MAX_CODELENGTH) && p->codes[n].name; n++) {
+    if (p->codes[n].name == codeName)
+      return (n);
+  }
+  if (p->manchester && (codeName == '0'))
+    return (SignalParser::BIT0);
+  if (p->manchester && (codeName == '1'))
+    return (SignalParser::BIT1);
+  return (-1);
+} // codeIndex()
+
+
+/** check if a protocol has a code that is a complete sequence. */
+static bool hasSingle(const SignalParser::Protocol *p)
+{
+  for (int n = 0; n < p->codeLength; n++) {
+    if (p->codes[n].type == SignalParser::CodeType::SINGLE)
+      return (true);
+  }
+  return (false);
+} // hasSingle()
+
+
 /** reset all codes in a protocol */
 void SignalParser::_resetCodes(Protocol *p)
 {
@@ -79,26 +109,69 @@ void SignalParser::_resetProtocol(Protocol *p)
 } // _resetProtocol()
 
 
-/** use the callback function when registered using format <protocolname> <sequence> */
+/** pass the sequence to the decoder and use the callback function when registered using format <protocolname> <sequence> */
 void SignalParser::_useCallback(Protocol *p)
 {
+  if (p && (_callbackFunc || _decoder)) {
+    if (_frameHook)
+      _frameHook();
+    if (_decoder)
+      _decoder->decode(p, p->seq, p->seqLen, _time);
+  }
+
   if (p && _callbackFunc) {
-    String code;
-    code += p->name;
-    code += ' ';
-    code += p->seq;
-    _callbackFunc(code.c_str());
+    char code[PROTNAME_LEN + 1 + MAX_SEQUENCE_LENGTH];
+    char *s = code;
+    const char *src = p->name;
+    while (*src) {
+      *s++ = *src++;
+    }
+    *s++ = ' ';
+    memcpy(s, p->seq, p->seqLen + 1);
+    _callbackFunc(code);
   }
 } // _useCallback()
 
 
-/** check if the duration fits for the protocol */
-void SignalParser::_parseProtocol(Protocol *p, CodeTime duration)
+/** validate and pass a complete sequence of the protocol with the index n */
+void SignalParser::_foundSequence(int n, CodeTime duration)
 {
+  Protocol *p = _protocol[n];
+
+  if (p->manchester) {
+    // the bits after the start code are passed as '0' and '1' codes.
+    for (int b = 0; b < p->seqLen - 1; b++) {
+      p->seq[b + 1] = ((p->data[b >> 3] >> (b & 7)) & 1) ? '1' : '0';
+    }
+    p->seq[p->seqLen] = NUL;
+  }
+
+  if (p->validate && !p->validate(p->seq, p->seqLen)) {
+    TRACE_EVENT(REJECT, n, p->seq[p->seqLen - 1], p->seqLen, duration);
+    p->stats.rejected++;
+  } else {
+    TRACE_EVENT(FRAME, n, p->seq[p->seqLen - 1], p->seqLen, duration);
+    p->stats.frames++;
+    _useCallback(p);
+  }
+  _resetProtocol(p);
+} // _foundSequence()
+
+
+/** check if the duration fits for the protocol with the index n */
+void SignalParser::_parseProtocol(int n, CodeTime duration)
+{
+  Protocol *p = _protocol[n];
   Code *c = p->codes;
   int cCnt = p->codeLength;
   bool anyValid = false;
   bool retryCandidate = false;
+  bool restart = false;
+
+  p->stats.durations++;
+
+  if (p->manchester && (p->seqLen > 0) && _parseManchester(n, duration))
+    return;
 
   while (c && cCnt) {
 
@@ -114,9 +187,12 @@ void SignalParser::_parseProtocol(Protocol *p, CodeTime duration)
         // codes other than start codes are nor acceptable as a first code in the sequence.
         // TRACE_MSG("  not start");
 
-      } else if ((p->seqLen > 0) && !(type & ANY)) {
+      } else if ((p->seqLen > 0) && (!(type & ANY) || (type == SINGLE))) {
         // codes other than data and end codes are nor acceptable during receiving.
+        // A single code sequence drops the partial sequence when nothing else fits.
         // TRACE_MSG("  not data");
+        if ((type == SINGLE) && (duration >= c->minTime[0]) && (duration <= c->maxTime[0]))
+          restart = true;
 
       } else if ((duration < c->minTime[i]) || (duration > c->maxTime[i])) {
         // This timing is not matching.
@@ -138,38 +214,63 @@ void SignalParser::_parseProtocol(Protocol *p, CodeTime duration)
       anyValid = anyValid || matched;
 
       if (retryCandidate) {
-        // reset this code only and try again.
         TRACE_MSG("  start retry...");
-        _resetProtocol(p);
+        TRACE_EVENT(RETRY, n, c->name, c->cnt, duration);
+        p->stats.retries++;
+        if (!hasSingle(p)) {
+          // reset the protocol and try again.
+          _resetProtocol(p);
+
+        } else {
+          // reset this code and try again, a single code in progress goes on
+          // as it may share the first timing with a start code.
+          for (Code *r = p->codes; r < p->codes + p->codeLength; r++) {
+            if ((r == c) || !r->valid || (r->cnt == 0)) {
+              r->valid = true;
+              r->cnt = 0;
+            }
+          } // for
+        }
 
 
       } else if (matched) {
         // this timing is matching
         TRACE_MSG("  matched.");
         c->cnt = i = i + 1;
+        TRACE_EVENT(MATCH, n, c->name, i, duration);
 
         if (i == c->timeLength) {
           // all timings received so add code-character.
+          if (p->seqLen == 0)
+            p->stats.starts++;
+          p->stats.symbols++;
           p->seq[p->seqLen++] = c->name;
           p->seq[p->seqLen] = NUL;
           // DEBUG_ESP_PORT.print(c->name);
           TRACE_MSG("  add '%s'", p->seq);
+          TRACE_EVENT(SYMBOL, n, c->name, p->seqLen, duration);
           _resetCodes(p); // reset all codes but not the protocol
 
-          if ((type == END) && (p->seqLen < p->minCodeLen)) {
+          if (p->manchester && (p->seqLen == 1)) {
+            // the bits follow the start code, its first timing has a high level.
+            p->level = (c->timeLength % 2) ? 0 : 1;
+            p->mid = (p->manchester & MANCHESTER_MID);
+          }
+
+          if ((type == END) && (p->seqLen < (int)p->minCodeLen)) {
             // End packet found but sequence was not started early enough
             TRACE_MSG("  end fragment: %s", p->seq);
+            TRACE_EVENT(FRAGMENT, n, c->name, p->seqLen, duration);
+            p->stats.fragments++;
             _resetProtocol(p);
 
-          } else if ((type & END) && (p->seqLen >= p->minCodeLen)) {
+          } else if ((type & END) && (p->seqLen >= (int)p->minCodeLen)) {
             TRACE_MSG("  found-1: %s", p->seq);
-            _useCallback(p);
-            _resetProtocol(p);
+            _foundSequence(n, duration);
 
-          } else if ((p->seqLen == p->maxCodeLen)) {
+          } else if ((p->seqLen == (int)p->maxCodeLen)) {
             TRACE_MSG("  found-2: %s", p->seq);
-            _useCallback(p);
-            _resetProtocol(p);
+            _foundSequence(n, duration);
           }
           break; // no more code checking in this protocol
         }        // if
@@ -188,14 +289,96 @@ void SignalParser::_parseProtocol(Protocol *p, CodeTime duration)
 
   if (!anyValid) {
     TRACE_MSG("  no codes.");
+    if (p->seqLen == 0) {
+      p->stats.notStart++;
+    } else {
+      TRACE_EVENT(RESET, n, NUL, p->seqLen, duration);
+      p->stats.outOfWindow++;
+    }
     _resetProtocol(p);
+
+    if (restart) {
+      // parse the duration again as the start of a new sequence, it is counted once.
+      TRACE_MSG("  restart.");
+      p->stats.durations--;
+      _parseProtocol(n, duration);
+    }
   }
 } // _parseProtocol()
 
 
+/** decode the duration as manchester bits of the protocol with the index n */
+bool SignalParser::_parseManchester(int n, CodeTime duration)
+{
+  Protocol *p = _protocol[n];
+  int halves = 0;
+  int bit = -1;
+
+  if ((duration >= p->halfMin[0]) && (duration <= p->halfMax[0])) {
+    halves = 1;
+  } else if ((duration >= p->halfMin[1]) && (duration <= p->halfMax[1])) {
+    halves = 2;
+  }
+
+  if (p->mid && (halves == 1)) {
+    // the second half of the current bit.
+    p->mid = false;
+
+  } else if (p->mid && (halves == 2)) {
+    // the second half of the current bit and the first half of the next bit.
+    bit = p->level;
+
+  } else if (!p->mid && (halves == 1)) {
+    // the first half of the next bit.
+    bit = p->level;
+    p->mid = true;
+
+  } else {
+    // a duration that doesn't fit or has no edge in the middle of a bit ends the sequence.
+    if (p->seqLen >= (int)p->minCodeLen) {
+      TRACE_MSG("  found-3: %d bits", p->seqLen - 1);
+      _foundSequence(n, duration);
+    } else {
+      TRACE_EVENT(RESET, n, NUL, p->seqLen, duration);
+      p->stats.outOfWindow++;
+      _resetProtocol(p);
+    }
+    return (false);
+  } // if
+
+  p->level = 1 - p->level;
+
+  if (bit >= 0) {
+    // the level of the first half is the bit.
+    if (p->manchester & MANCHESTER_INVERT)
+      bit = 1 - bit;
+
+    int b = p->seqLen - 1;
+    if ((b & 7) == 0)
+      p->data[b >> 3] = 0;
+    p->data[b >> 3] |= (bit << (b & 7));
+    p->seqLen++;
+    p->stats.symbols++;
+    TRACE_EVENT(SYMBOL, n, bit ? '1' : '0', p->seqLen, duration);
+
+    if (p->seqLen == (int)p->maxCodeLen) {
+      TRACE_MSG("  found-2: %d bits", p->seqLen - 1);
+      _foundSequence(n, duration);
+    }
+  } // if
+  return (true);
+} // _parseManchester()
+
+
 // ===== public functions =====
 
 
+SignalParser::~SignalParser()
+{
+  free(_protocol);
+} // ~SignalParser()
+
+
 /** attach a callback function that will get passed any new code. */
 void SignalParser::attachCallback(CallbackFunction newFunction)
 {
@@ -203,8 +386,32 @@ void SignalParser::attachCallback(CallbackFunction newFunction)
 } // attachCallback()
 
 
+/** attach a hook that is called right before the callback function. */
+void SignalParser::attachFrameHook(FrameHookFunction newFunction)
+{
+  _frameHook = newFunction;
+} // attachFrameHook()
+
+
+/** attach a decoder that gets every detected sequence before the callback function. */
+void SignalParser::attachDecoder(SignalDecoder *decoder)
+{
+  _decoder = decoder;
+} // attachDecoder()
+
+
+/** set the validate function of a loaded protocol. */
+bool SignalParser::attachValidator(const char *name, ValidateFunction validateFunc)
+{
+  Protocol *p = name ? _findProt(name) : nullptr;
+  if (p)
+    p->validate = validateFunc;
+  return (p != nullptr);
+} // attachValidator()
+
+
 // return the number of send repeats that should occure.
-int SignalParser::getSendRepeat(char *name)
+int SignalParser::getSendRepeat(const char *name)
 {
   Protocol *p = _findProt(name);
   return (p ? p->sendRepeat : 0);
@@ -216,58 +423,309 @@ int SignalParser::getSendRepeat(char *name)
 void SignalParser::parse(CodeTime duration)
 {
   TRACE_MSG("(%d)", duration);
+  TRACE_EVENT(DURATION, SIGNALTRACE_NOPROTOCOL, NUL, _protocolCount, duration);
+  _time += duration;
 
   for (int n = 0; n < _protocolCount; n++) {
-    _parseProtocol(_protocol[n], duration);
+    _parseProtocol(n, duration);
   }
 } // parse()
 
 
+/** parse a batch of durations. */
+void SignalParser::parse(const CodeTime *durations, int count)
+{
+  for (_batchIndex = 0; _batchIndex < count; _batchIndex++) {
+    CodeTime duration = durations[_batchIndex];
+    TRACE_EVENT(DURATION, SIGNALTRACE_NOPROTOCOL, NUL, _protocolCount, duration);
+    _time += duration;
+
+    for (int n = 0; n < _protocolCount; n++) {
+      _parseProtocol(n, duration);
+    }
+  } // for
+  _batchIndex = 0;
+} // parse()
+
+
+/** reset all protocols to start capturing from scratch. */
+void SignalParser::reset()
+{
+  for (int n = 0; n < _protocolCount; n++) {
+    _resetProtocol(_protocol[n]);
+  }
+} // reset()
+
+
 /** compose the timings of a sequence by using the code table.
  * @param sequence textual representation using "<protocolname> <codes>".
+ * @param timings buffer for the timings, ending with a 0 time.
+ * @param len size of the timings buffer including the ending 0 time.
+ * @return number of timings without the ending 0 time or a ComposeError.
  */
-void SignalParser::compose(const char *sequence, CodeTime *timings, int len)
+int SignalParser::compose(const char *sequence, CodeTime *timings, int len)
 {
   char protname[PROTNAME_LEN];
 
-  char *s = strchr(sequence, ' ');
+  if (timings && (len > 0))
+    *timings = 0;
 
-  if (s) {
-    // extract protname
-    {
-      char *tar = protname;
-      const char *src = sequence;
-      while (*src && (*src != ' ')) {
-        *tar++ = *src++;
-      }
-      *tar = NUL;
+  const char *s = sequence ? strchr(sequence, ' ') : nullptr;
+  if (!s || (s - sequence >= PROTNAME_LEN))
+    return (COMPOSE_SYNTAX);
+
+  // extract protname
+  memcpy(protname, sequence, s - sequence);
+  protname[s - sequence] = NUL;
+  Protocol *p = _findProt(protname);
+  if (!p)
+    return (COMPOSE_PROTOCOL);
+
+  s++; // to start of code characters
+
+  if (p->manchester) {
+    // the bits are joined by the encoder.
+    Handle handle;
+    int ret = compile(sequence, &handle);
+    return ((ret < 0) ? ret : compose(&handle, timings, len));
+  }
+
+  // check the codes and count the timings first.
+  int cnt = 0;
+  for (const char *n = s; *n; n++) {
+    Code *c = _findCode(p, *n);
+    if (!c)
+      return (COMPOSE_CODE);
+    cnt += c->timeLength;
+  } // for
+
+  if (timings && (cnt < len)) {
+    for (; *s; s++) {
+      Code *c = _findCode(p, *s);
+      for (int i = 0; i < c->timeLength; i++) {
+        *timings++ = (c->minTime[i] + c->maxTime[i]) / 2;
+      } // for
+    } // for
+    *timings = 0;
+  } // if
+  return (cnt);
+} // compose()
+
+
+/** compile a sequence into a handle. */
+int SignalParser::compile(const char *sequence, Handle *handle)
+{
+  char protname[PROTNAME_LEN];
+
+  if (!handle)
+    return (COMPOSE_SYNTAX);
+  handle->protocol = nullptr;
+  handle->length = 0;
+
+  const char *s = sequence ? strchr(sequence, ' ') : nullptr;
+  if (!s || (s - sequence >= PROTNAME_LEN))
+    return (COMPOSE_SYNTAX);
+
+  memcpy(protname, sequence, s - sequence);
+  protname[s - sequence] = NUL;
+  Protocol *p = _findProt(protname);
+  if (!p)
+    return (COMPOSE_PROTOCOL);
+
+  for (s++; *s; s++) {
+    int index = codeIndex(p, *s);
+    if ((index < 0) || ((index >= p->codeLength) && (index < BIT0))) {
+      handle->length = 0;
+      return (COMPOSE_CODE);
+    }
+    if (handle->length >= (int)sizeof(handle->code)) {
+      handle->length = 0;
+      return (COMPOSE_LENGTH);
     }
-    Protocol *p = _findProt(protname);
+    handle->code[handle->length++] = (unsigned char)index;
+  } // for
+  handle->protocol = p;
+  return (handle->length);
+} // compile()
 
-    s++; // to start of code characters
 
-    if (p && timings) {
-      while (*s && len) {
-        Code *c = _findCode(p, *s);
-        if (c) {
-          for (int i = 0; i < c->timeLength; i++) {
-            *timings++ = (c->minTime[i] + c->maxTime[i]) / 2;
-          } // for
-        }
-        s++;
-        len--;
-      }
-      *timings = 0;
-    } // if
+/** start an empty compiled sequence. */
+void SignalParser::begin(Handle *handle, Protocol *protocol)
+{
+  if (handle) {
+    handle->protocol = protocol;
+    handle->length = 0;
   }
+} // begin()
+
+
+/** append a code to a compiled sequence. */
+bool SignalParser::append(Handle *handle, char codeName)
+{
+  if (!handle || !handle->protocol || (handle->length >= (int)sizeof(handle->code)))
+    return (false);
+
+  // the codes are searched by name so a protocol that is not loaded yet can be used.
+  int index = codeIndex(handle->protocol, codeName);
+  if (index < 0)
+    return (false);
+  handle->code[handle->length++] = (unsigned char)index;
+  return (true);
+} // append()
+
+
+/** append the bits of a value to a compiled sequence. */
+bool SignalParser::appendBits(Handle *handle, unsigned long value, int bits, char zero, char one, bool lsbFirst)
+{
+  // find the codes only once.
+  if (!append(handle, zero))
+    return (false);
+  unsigned char zeroIndex = handle->code[--handle->length];
+  if (!append(handle, one))
+    return (false);
+  unsigned char oneIndex = handle->code[--handle->length];
+
+  if ((bits < 0) || (bits > (int)(8 * sizeof(value))) || (handle->length + bits > (int)sizeof(handle->code)))
+    return (false);
+
+  for (int n = 0; n < bits; n++) {
+    int bit = lsbFirst ? n : bits - 1 - n;
+    handle->code[handle->length++] = ((value >> bit) & 1) ? oneIndex : zeroIndex;
+  }
+  return (true);
+} // appendBits()
+
+
+/** compose the timings of a compiled sequence. */
+int SignalParser::compose(const Handle *handle, CodeTime *timings, int len)
+{
+  if (timings && (len > 0))
+    *timings = 0;
+
+  if (!handle || !handle->protocol)
+    return (COMPOSE_PROTOCOL);
+
+  int cnt = 0;
+
+  if (handle->protocol->manchester) {
+    // the number of timings is known after joining the half bits.
+    Encoder encoder;
+    encoder.begin(handle);
+    while (encoder.next())
+      cnt++;
+
+    if (timings && (cnt < len)) {
+      encoder.begin(handle);
+      while ((*timings = encoder.next()))
+        timings++;
+    }
+    return (cnt);
+  } // if
+
+  for (int n = 0; n < handle->length; n++) {
+    cnt += handle->protocol->codes[handle->code[n]].timeLength;
+  }
+
+  if (timings && (cnt < len)) {
+    for (int n = 0; n < handle->length; n++) {
+      Code *c = &(handle->protocol->codes[handle->code[n]]);
+      for (int i = 0; i < c->timeLength; i++) {
+        *timings++ = (c->minTime[i] + c->maxTime[i]) / 2;
+      } // for
+    } // for
+    *timings = 0;
+  } // if
+  return (cnt);
 } // compose()
 
+
+/** start encoding a compiled sequence. */
+void SignalParser::Encoder::begin(const Handle *h)
+{
+  handle = (h && h->protocol) ? h : nullptr;
+  code = 0;
+  time = 0;
+  level = 1;
+} // begin()
+
+
+/** return the next timing or 0 at the end of the sequence. */
+SignalParser::CodeTime IRAM_ATTR SignalParser::Encoder::next()
+{
+  while (handle && (code < handle->length)) {
+    const Protocol *p = handle->protocol;
+
+    if (handle->code[code] >= BIT0) {
+      // manchester bits: join the following half bits with the same level.
+      CodeTime t = 0;
+      while ((code < handle->length) && (handle->code[code] >= BIT0)) {
+        int first = (handle->code[code] == BIT1) ? 1 : 0;
+        if (p->manchester & MANCHESTER_INVERT)
+          first = 1 - first;
+        int half = (time < 0) ? level : (time == 0) ? first : 1 - first;
+        if (t && (half != level))
+          break;
+        level = half;
+        t += p->baseTime;
+        if (++time > 1) {
+          code++;
+          time = 0;
+        }
+      } // while
+      level = 1 - level;
+      return (t);
+    } // if
+
+    const Code *c = &(p->codes[handle->code[code]]);
+    if (time < c->timeLength) {
+      CodeTime t = (c->minTime[time] + c->maxTime[time]) / 2;
+      time++;
+      level = 1 - level;
+      return (t);
+    }
+    code++;
+    time = 0;
+
+    // the second half of the bit that ends the start code comes first.
+    if ((code < handle->length) && (handle->code[code] >= BIT0) && (p->manchester & MANCHESTER_MID))
+      time = -1;
+  } // while
+  return (0);
+} // next()
+
+
+/** get the textual representation of a compiled sequence. */
+void SignalParser::getText(const Handle *handle, char *text, int len)
+{
+  if (!text || (len <= 0))
+    return;
+
+  int n = 0;
+  if (handle && handle->protocol) {
+    const char *name = handle->protocol->name;
+    while (*name && (n < len - 1))
+      text[n++] = *name++;
+    if (n < len - 1)
+      text[n++] = ' ';
+    for (int i = 0; (i < handle->length) && (n < len - 1); i++) {
+      unsigned char index = handle->code[i];
+      text[n++] = (index == BIT0) ? '0' : (index == BIT1) ? '1' : handle->protocol->codes[index].name;
+    }
+  } // if
+  text[n] = NUL;
+} // getText()
+
 /** Load a protocol to be used. */
 void SignalParser::load(Protocol *protocol)
 {
   if (protocol) {
     TRACE_MSG("loading protocol %s", protocol->name);
 
+    // protect against incomplete definitions
+    protocol->name[PROTNAME_LEN - 1] = NUL;
+    if ((protocol->maxCodeLen == 0) || (protocol->maxCodeLen > MAX_SEQUENCE_LENGTH - 1))
+      protocol->maxCodeLen = MAX_SEQUENCE_LENGTH - 1;
+
     // get space for protocol definition
     if (_protocolCount >= _protocolAlloc) {
       _protocolAlloc += 8;
@@ -282,20 +740,21 @@ void SignalParser::load(Protocol *protocol)
 
     CodeTime baseTime = protocol->baseTime;
 
-    // calc min and max and codesLength
+    // calc min and max and codesLength, a code without timings ends the table
     int cl = 0;
-    while ((cl < MAX_CODELENGTH) && (protocol->codes[cl].name)) {
+    while ((cl < MAX_CODELENGTH) && (protocol->codes[cl].name) && (protocol->codes[cl].time[0])) {
       Code *c = &(protocol->codes[cl]);
 
       // calculate # of durations and absolute timing boundaries
       int tl = 0;
       while ((tl < MAX_TIMELENGTH) && (c->time[tl])) {
-        CodeTime t = baseTime * c->time[tl];
-        int radius = (t * protocol->tolerance) / 100;
-        TRACE_MSG("== %d %d %d %d ", baseTime, c->time[tl], t, radius);
+        unsigned long long t = (unsigned long long)baseTime * c->time[tl];
+        unsigned long long radius = (t * protocol->tolerance) / 100;
+        unsigned long long maxTime = t + radius;
+        TRACE_MSG("== %d %d %d %d ", baseTime, c->time[tl], (int)t, (int)radius);
 
-        c->minTime[tl] = t - radius;
-        c->maxTime[tl] = t + radius;
+        c->minTime[tl] = (radius < t) ? (CodeTime)(t - radius) : 0;
+        c->maxTime[tl] = (maxTime < (CodeTime)~0) ? (CodeTime)maxTime : (CodeTime)~0;
         tl++;
       } // while
       c->timeLength = tl;
@@ -304,7 +763,18 @@ void SignalParser::load(Protocol *protocol)
     }                          // while
     protocol->codeLength = cl; // no need to specify codeLength
 
+    // calc the limits of durations with one and two half bits in manchester mode.
+    for (int h = 0; h < 2; h++) {
+      unsigned long long t = (unsigned long long)baseTime * (h + 1);
+      unsigned long long radius = (t * protocol->tolerance) / 100;
+      unsigned long long maxTime = t + radius;
+
+      protocol->halfMin[h] = (radius < t) ? (CodeTime)(t - radius) : 0;
+      protocol->halfMax[h] = (maxTime < (CodeTime)~0) ? (CodeTime)maxTime : (CodeTime)~0;
+    } // for
+
     _resetProtocol(protocol);
+    memset(&(protocol->stats), 0, sizeof(Statistics));
 
     for (int n = 0; n < _protocolCount; n++) {
       TRACE_MSG(" reg[%d] = %08x", n, _protocol[n]);
@@ -314,4 +784,82 @@ void SignalParser::load(Protocol *protocol)
   } // if
 } // load()
 
+
+/** get the limits of the loaded protocols. */
+void SignalParser::getLimits(CodeTime *minTime, CodeTime *maxTime, int *minLength, const char *name)
+{
+  CodeTime minT = (CodeTime)~0;
+  CodeTime maxT = 0;
+  int minL = MAX_TIMING_LENGTH;
+
+  for (int n = 0; n < _protocolCount; n++) {
+    Protocol *p = _protocol[n];
+    int minTimeLength = MAX_TIMELENGTH;
+
+    if (name && (strcmp(name, p->name) != 0))
+      continue;
+
+    for (int c = 0; c < p->codeLength; c++) {
+      Code *code = &(p->codes[c]);
+      for (int t = 0; t < code->timeLength; t++) {
+        if (code->minTime[t] < minT)
+          minT = code->minTime[t];
+        if (code->maxTime[t] > maxT)
+          maxT = code->maxTime[t];
+      }
+      if (code->timeLength < minTimeLength)
+        minTimeLength = code->timeLength;
+    } // for
+
+    if (p->manchester) {
+      if (p->halfMin[0] < minT)
+        minT = p->halfMin[0];
+      if (p->halfMax[1] > maxT)
+        maxT = p->halfMax[1];
+    }
+
+    // a sequence ends with an end code after minCodeLen or with maxCodeLen codes.
+    int codes = (p->minCodeLen < p->maxCodeLen) ? p->minCodeLen : p->maxCodeLen;
+    if (codes < 1)
+      codes = 1;
+    // in manchester mode every bit after the start code ends at least one duration.
+    int length = p->manchester ? minTimeLength + codes - 1 : codes * minTimeLength;
+    if (length < minL)
+      minL = length;
+  } // for
+
+  if (minT > maxT)
+    minT = maxT = 0; // no protocols
+  if (minL < 1)
+    minL = 1;
+
+  if (minTime)
+    *minTime = minT;
+  if (maxTime)
+    *maxTime = maxT;
+  if (minLength)
+    *minLength = minL;
+} // getLimits()
+
+
+/** get a copy of the statistics counters of a loaded protocol. */
+bool SignalParser::getStatistics(const char *name, Statistics *stats)
+{
+  Protocol *p = name ? _findProt(name) : nullptr;
+  if (p && stats)
+    *stats = p->stats;
+  return (p != nullptr);
+} // getStatistics()
+
+
+/** reset the statistics counters. */
+void SignalParser::resetStatistics(const char *name)
+{
+  for (int n = 0; n < _protocolCount; n++) {
+    Protocol *p = _protocol[n];
+    if (!name || (strcmp(name, p->name) == 0))
+      memset(&(p->stats), 0, sizeof(Statistics));
+  }
+} // resetStatistics()
+
 // End.
\ No newline at end of file
@@ -16,6 +16,24 @@
  * Changelog:
  * * 29.04.2018 created by Matthias Hertel
  * * 06.08.2018 const char send, allow for sending only.
+ * * 16.10.2026 no Arduino String, to run on host systems.
+ * * 16.10.2026 bounds checks in compose() and load() for untrusted input.
+ * * 16.10.2026 statistics counters per protocol.
+ * * 16.10.2026 binary trace events, see SignalTrace.h.
+ * * 16.10.2026 frame hook for measuring the latency.
+ * * 16.10.2026 parse a batch of durations.
+ * * 16.10.2026 timing limits of the loaded protocols.
+ * * 16.10.2026 compiled sequences for sending without searching.
+ * * 16.10.2026 streaming encoder for compiled sequences.
+ * * 16.10.2026 compose() returns the number of timings or an error.
+ * * 16.10.2026 build compiled sequences from values, see protocols.h.
+ * * 16.10.2026 value records by a SignalDecoder.
+ * * 16.10.2026 validate function per protocol before passing a sequence.
+ * * 16.10.2026 SINGLE code type for sequences of one code.
+ * * 16.10.2026 manchester mode that decodes the data after the start code into bits.
+ * * 16.10.2026 single codes only at the start of a sequence.
+ * * 16.10.2026 partial reset on retries only for protocols with single codes.
+ * * 16.10.2026 time of the stream from the parsed durations.
  */
 
 // .h
@@ -38,6 +56,7 @@
 // #include <cstring >
 
 #include "debugout.h"
+#include "SignalTrace.h"
 
 #define NUL '\0'
 
@@ -49,6 +68,8 @@
 
 #define PROTNAME_LEN 12 // maximal protocol name len including ending '\0'
 
+class SignalDecoder;
+
 class SignalParser
 {
 public:
@@ -61,9 +82,28 @@ public:
     DATA = 0x02,              // A code containing some information
     END = 0x04,               // This code ends a sequence
     ANYDATA = (START | DATA), // A code with data can be used to start a sequence
-    ANY = (DATA | END)        // A code with data that can end the sequence
+    ANY = (DATA | END),       // A code with data that can end the sequence
+    SINGLE = (START | END)    // A code that is a complete sequence
   } CodeType;
 
+  // Flags of the manchester mode of a protocol.
+  // In manchester mode the durations after a start code are decoded directly
+  // into bits using baseTime as the time of a half bit. The first timing of
+  // the start code is a high level. The bits are passed as '0' and '1' codes.
+  typedef enum {
+    MANCHESTER = 0x01,        // decode the data after the start code as manchester bits.
+    MANCHESTER_INVERT = 0x02, // a 1 bit is sent as low-high instead of high-low.
+    MANCHESTER_MID = 0x04     // the start code ends with the first half of a bit that is not passed.
+  } ManchesterMode;
+
+  // Errors returned by compose() and compile().
+  typedef enum {
+    COMPOSE_SYNTAX = -1,   // the sequence doesn't start with "<protocolname> ".
+    COMPOSE_PROTOCOL = -2, // the protocol is not loaded.
+    COMPOSE_CODE = -3,     // a character is not a code of the protocol.
+    COMPOSE_LENGTH = -4    // too many codes for a handle.
+  } ComposeError;
+
   // timings are using CodeTime datatypes meaning µsecs.
   typedef unsigned int CodeTime;
 
@@ -87,6 +127,24 @@ public:
   };            // struct Code
 
 
+  // The Statistics structure holds the counters of a protocol while parsing.
+  // The counters wrap around and can be cleared by resetStatistics().
+  struct Statistics {
+    unsigned long durations;   // durations examined.
+    unsigned long starts;      // start codes accepted as the first code of a sequence.
+    unsigned long symbols;     // codes accepted and added to the sequence.
+    unsigned long notStart;    // durations that did not fit any start code.
+    unsigned long outOfWindow; // sequences dropped by a duration not fitting any code.
+    unsigned long fragments;   // sequences dropped by an end code before minCodeLen.
+    unsigned long frames;      // complete sequences passed to the callback.
+    unsigned long rejected;    // complete sequences dropped by the validate function.
+    unsigned long retries;     // durations reanalyzed as a first duration for starting.
+  }; // struct Statistics
+
+
+  // Function that checks the codes of a complete sequence without the protocol name.
+  typedef bool (*ValidateFunction)(const char *seq, int len);
+
   // The Protocol structure is used to hold the basic settings for a protocol.
   struct Protocol {
     // These members must be initialized for load():
@@ -110,18 +168,69 @@ public:
 
     Code codes[MAX_CODELENGTH];
 
+    // optional check of checksums and fixed values, invalid sequences are dropped.
+    ValidateFunction validate;
+
+    // ManchesterMode flags, 0 for decoding the data by the codes.
+    unsigned int manchester;
+
     // ===== These members are used while parsing:
 
     // Number of defined codes in this table
     int codeLength;
     char seq[MAX_SEQUENCE_LENGTH];
     int seqLen;
+
+    // manchester mode: limits of a duration with one and two half bits.
+    CodeTime halfMin[2];
+    CodeTime halfMax[2];
+
+    // manchester mode: the received bits, the first bit is bit 0 of data[0].
+    unsigned char data[MAX_SEQUENCE_LENGTH / 8 + 1];
+    int level; // level of the next duration, HIGH = 1.
+    bool mid;  // the next duration starts in the middle of a bit.
+
+    Statistics stats;
   }; // struct Protocol
 
 
+  // A sequence compiled by compile() for composing it many times without
+  // searching the protocol and the codes. The protocol must stay loaded.
+  struct Handle {
+    Protocol *protocol;                         // protocol of the sequence.
+    int length;                                 // number of codes.
+    unsigned char code[MAX_SEQUENCE_LENGTH - 1]; // index of every code in protocol->codes or BIT0, BIT1.
+  }; // struct Handle
+
+  // Code indexes in a handle of the '0' and '1' bits of a protocol in manchester mode.
+  typedef enum {
+    BIT0 = 0xFE,
+    BIT1 = 0xFF
+  } BitCode;
+
+
+  // Streaming encoder that returns the timings of a compiled sequence one by
+  // one without a buffer. next() can be used in interrupt service routines.
+  struct Encoder {
+    const Handle *handle; // the sequence, it must not change while encoding.
+    int code;             // index of the current code in the handle.
+    int time;             // index of the next timing of the current code or half of the current bit.
+    int level;            // level of the next timing, HIGH = 1.
+
+    /** start encoding a compiled sequence. */
+    void begin(const Handle *h);
+
+    /** return the next timing or 0 at the end of the sequence. */
+    CodeTime next();
+  }; // struct Encoder
+
+
   // Callback when a code sequence was detected.
   typedef void (*CallbackFunction)(const char *code);
 
+  // Hook called right before the callback function of a detected sequence.
+  typedef void (*FrameHookFunction)();
+
 
   // ===== Functions =====
 
@@ -129,14 +238,18 @@ private:
   // ===== class variables =====
 
   /** Protocol table and related settings */
-  Protocol **_protocol;
+  Protocol **_protocol = nullptr;
   int _protocolAlloc = 0;
   int _protocolCount = 0;
 
-  CallbackFunction _callbackFunc;
+  CallbackFunction _callbackFunc = nullptr;
+  int _batchIndex = 0;
+  unsigned long _time = 0; // sum of the parsed durations
+  FrameHookFunction _frameHook = nullptr;
+  SignalDecoder *_decoder = nullptr;
 
   /** find protocol by name */
-  Protocol *_findProt(char *name);
+  Protocol *_findProt(const char *name);
 
   /** find code by name */
   Code *_findCode(Protocol *p, char codeName);
@@ -150,31 +263,156 @@ private:
   /** use the callback function when registered using format <protocolname> <sequence> */
   void _useCallback(Protocol *p);
 
-  /** check if the duration fits for the protocol */
-  void _parseProtocol(Protocol *p, CodeTime duration);
+  /** validate and pass a complete sequence of the protocol with the index n */
+  void _foundSequence(int n, CodeTime duration);
+
+  /** check if the duration fits for the protocol with the index n */
+  void _parseProtocol(int n, CodeTime duration);
+
+  /** decode the duration as manchester bits of the protocol with the index n.
+   * @return false when the duration ended the sequence and has to be checked for a start code.
+   */
+  bool _parseManchester(int n, CodeTime duration);
 
   // ===== public functions =====
 
 public:
+  SignalParser() = default;
+  SignalParser(const SignalParser &) = delete;
+  SignalParser &operator=(const SignalParser &) = delete;
+  ~SignalParser();
+
   /** attach a callback function that will get passed any new code. */
   void attachCallback(CallbackFunction newFunction);
 
+  /** attach a hook that is called right before the callback function.
+   * This is used by the SignalCollector to measure the latency.
+   */
+  void attachFrameHook(FrameHookFunction newFunction);
+
+  /** attach a decoder that gets every detected sequence before the callback function.
+   * @param decoder the decoder or nullptr.
+   */
+  void attachDecoder(SignalDecoder *decoder);
+
+  /** set the validate function of a loaded protocol that checks every complete sequence before it is passed on.
+   * @param name name of the protocol.
+   * @param validateFunc the function or nullptr to pass all sequences.
+   * @return true when the protocol was found.
+   */
+  bool attachValidator(const char *name, ValidateFunction validateFunc);
+
   // return the number of send repeats that should occure.
-  int getSendRepeat(char *name);
+  int getSendRepeat(const char *name);
 
   /** parse a single duration.
    * @param duration check if this duration fits to any definitions.
   */
   void parse(CodeTime duration);
 
+  /** parse a batch of durations.
+   * @param durations list of durations.
+   * @param count number of durations.
+   */
+  void parse(const CodeTime *durations, int count);
+
+  /** return the index of the duration in the batch that completed the sequence
+   * while called from the callback function.
+   */
+  int getBatchIndex()
+  {
+    return (_batchIndex);
+  };
+
+  /** return the time in µsecs at the end of the last parsed duration.
+   * This is the sum of all parsed durations and also works for recorded streams.
+   */
+  unsigned long getTime()
+  {
+    return (_time);
+  };
+
+  /** reset all protocols to start capturing from scratch. */
+  void reset();
+
   /** compose the timings of a sequence by using the code table.
+   * The timings are written only when all of them and the ending 0 time fit
+   * into the buffer, otherwise an empty sequence is written. Use timings =
+   * nullptr to get the needed size.
    * @param sequence textual representation using "<protocolname> <codes>".
+   * @param timings buffer for the timings, ending with a 0 time.
+   * @param len size of the timings buffer including the ending 0 time.
+   * @return number of timings without the ending 0 time or a ComposeError.
+   */
+  int compose(const char *sequence, CodeTime *timings, int len);
+
+  /** compile a sequence into a handle.
+   * @param sequence textual representation using "<protocolname> <codes>".
+   * @param handle buffer for the compiled sequence.
+   * @return number of codes or a ComposeError.
+   */
+  int compile(const char *sequence, Handle *handle);
+
+  /** start an empty compiled sequence for building it by append() instead of compile().
+   * @param handle buffer for the compiled sequence.
+   * @param protocol the protocol, it must be loaded before composing.
+   */
+  static void begin(Handle *handle, Protocol *protocol);
+
+  /** append a code to a compiled sequence.
+   * @return false when the code is not defined by the protocol or the handle is full.
+   */
+  static bool append(Handle *handle, char codeName);
+
+  /** append the bits of a value to a compiled sequence using a code for 0 and a code for 1.
+   * @param value the value.
+   * @param bits number of bits to append, starting with the highest bit.
+   * @param zero code for a 0 bit.
+   * @param one code for a 1 bit.
+   * @param lsbFirst start with the lowest bit.
+   * @return false when a code is not defined by the protocol or the handle is full.
    */
-  void compose(const char *sequence, CodeTime *timings, int len);
+  static bool appendBits(Handle *handle, unsigned long value, int bits, char zero, char one, bool lsbFirst = false);
+
+  /** compose the timings of a compiled sequence like compose() of a text.
+   * @param handle the sequence compiled by compile().
+   * @param timings buffer for the timings, ending with a 0 time.
+   * @param len size of the timings buffer including the ending 0 time.
+   * @return number of timings without the ending 0 time or a ComposeError.
+   */
+  static int compose(const Handle *handle, CodeTime *timings, int len);
+
+  /** get the textual representation of a compiled sequence.
+   * @param handle the sequence compiled by compile().
+   * @param text buffer for the text.
+   * @param len size of the text buffer, PROTNAME_LEN + MAX_SEQUENCE_LENGTH is always enough.
+   */
+  static void getText(const Handle *handle, char *text, int len);
 
   /** Load a protocol to be used. */
   void load(Protocol *protocol);
 
+  /** get the limits of the loaded protocols.
+   * Durations outside of minTime..maxTime don't fit to any code and reset all protocols.
+   * @param minTime shortest duration that fits to a code.
+   * @param maxTime longest duration that fits to a code.
+   * @param minLength minimal number of durations in a sequence.
+   * @param name name of a single protocol or nullptr for all loaded protocols.
+   */
+  void getLimits(CodeTime *minTime, CodeTime *maxTime, int *minLength, const char *name = nullptr);
+
+  /** get a copy of the statistics counters of a loaded protocol.
+   * @param name name of the protocol.
+   * @param stats buffer for the counters.
+   * @return true when the protocol was found.
+   */
+  bool getStatistics(const char *name, Statistics *stats);
+
+  /** reset the statistics counters.
+   * @param name name of the protocol or nullptr for all loaded protocols.
+   */
+  void resetStatistics(const char *name = nullptr);
+
 
   // ===== debug helpers =====
 
@@ -203,10 +441,26 @@ public:
         c++;
         cnt--;
       } // while
+
+      if (p->manchester) {
+        RAW_MSG("  bits|%5d -%5d |%5d -%5d | mode:%u\n", p->halfMin[0], p->halfMax[0], p->halfMin[1], p->halfMax[1], p->manchester);
+      }
       RAW_MSG("\n");
     } // if
   }   // dumpProtocol()
 
+  /** Send the statistics counters of all protocols to the output. */
+  void dumpStatistics()
+  {
+    for (int n = 0; n < _protocolCount; n++) {
+      Protocol *p = _protocol[n];
+      Statistics *st = &(p->stats);
+      RAW_MSG("Protocol '%s', dur:%lu start:%lu sym:%lu notstart:%lu window:%lu frag:%lu frames:%lu rejected:%lu retry:%lu\n",
+              p->name, st->durations, st->starts, st->symbols, st->notStart,
+              st->outOfWindow, st->fragments, st->frames, st->rejected, st->retries);
+    } // for
+  }   // dumpStatistics()
+
   /** Send a summary of the current code-table to the output. */
   void dumpTable()
   {
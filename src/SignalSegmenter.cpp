@@ -0,0 +1,168 @@
+/**
+ * @file SignalSegmenter.cpp
+ *
+ * This file is part of the RFCodes library that implements receiving an sending
+ * RF and IR protocols.
+ *
+ * @copyright Copyright (c) by Matthias Hertel, https://www.mathertel.de.
+ *
+ * This work is licensed under a BSD 3-Clause style license,
+ * https://www.mathertel.de/License.aspx.
+ *
+ * @brief
+ * Optional stage between the SignalCollector and the SignalParser that passes
+ * only bursts of plausible durations to the parser.
+ *
+ * Change History see SignalSegmenter.h
+ */
+
+#include <string.h>
+
+#include "SignalSegmenter.h"
+
+
+/** initialize the limits from the protocols loaded into the parser. */
+void SignalSegmenter::init(SignalParser *sig)
+{
+  _sig = sig;
+  if (_sig)
+    _sig->getLimits(&_minTime, &_maxTime, &_minLength);
+  _protocolMin = _minTime;
+  _protocolMax = _maxTime;
+  setMinLength(_minLength);
+  reset();
+} // init()
+
+
+/** narrow the range of plausible durations. */
+void SignalSegmenter::setLimits(SignalParser::CodeTime minTime, SignalParser::CodeTime maxTime)
+{
+  _minTime = minTime;
+  _maxTime = maxTime;
+} // setLimits()
+
+
+/** set the minimal number of durations in a burst. */
+void SignalSegmenter::setMinLength(int len)
+{
+  if (len < 1)
+    len = 1;
+  if (len > SIGNALSEGMENTER_SIZE)
+    len = SIGNALSEGMENTER_SIZE;
+  _minLength = len;
+} // setMinLength()
+
+
+/** attach a hook function that is called when a passed burst has ended. */
+void SignalSegmenter::attachBurstHook(BurstFunction newFunction)
+{
+  _burstFunc = newFunction;
+} // attachBurstHook()
+
+
+/** process a single duration. */
+void SignalSegmenter::parse(SignalParser::CodeTime duration)
+{
+  _stats.durations++;
+
+  if ((duration < _minTime) || (duration > _maxTime)) {
+    _endBurst(duration);
+
+  } else {
+    if (_burst.count == 0) {
+      _burst.index = _index;
+      _burst.length = 0;
+      _burst.minDuration = _burst.maxDuration = duration;
+    } else if (duration < _burst.minDuration) {
+      _burst.minDuration = duration;
+    } else if (duration > _burst.maxDuration) {
+      _burst.maxDuration = duration;
+    }
+    _burst.length += duration;
+
+    if (_burst.count < SIGNALSEGMENTER_SIZE)
+      _buffer[_burst.count] = duration;
+    _burst.count++;
+
+    if (_passing) {
+      _pass(duration, _index);
+
+    } else if ((int)_burst.count >= _minLength) {
+      // the burst is long enough, pass the buffered durations.
+      _passing = true;
+      for (unsigned int n = 0; n < _burst.count; n++) {
+        _pass(_buffer[n], _burst.index + n);
+      }
+    } // if
+  } // if
+
+  _index++;
+} // parse()
+
+
+/** drop the current burst and start with stream index 0. */
+void SignalSegmenter::reset()
+{
+  if (_sig && !_clean)
+    _sig->reset();
+  _clean = true;
+  _passing = false;
+  _burst.count = 0;
+  _index = 0;
+  _parseIndex = 0;
+} // reset()
+
+
+/** get a copy of the counters. */
+void SignalSegmenter::getStatistics(Statistics *stats)
+{
+  if (stats)
+    *stats = _stats;
+} // getStatistics()
+
+
+/** reset the counters. */
+void SignalSegmenter::resetStatistics()
+{
+  memset(&_stats, 0, sizeof(Statistics));
+} // resetStatistics()
+
+
+// pass a duration to the parser.
+void SignalSegmenter::_pass(SignalParser::CodeTime duration, unsigned long index)
+{
+  _stats.passed++;
+  _parseIndex = index;
+  _clean = false;
+  if (_sig)
+    _sig->parse(duration);
+} // _pass()
+
+
+// a duration outside of the limits ends the current burst.
+void SignalSegmenter::_endBurst(SignalParser::CodeTime gap)
+{
+  // the gap resets all protocols, only needed after passing durations.
+  if (!_clean) {
+    _pass(gap, _index);
+    if (_sig && (gap >= _protocolMin) && (gap <= _protocolMax))
+      _sig->reset(); // limits are narrowed, the gap may fit to a code.
+    _clean = true;
+  }
+
+  if (_burst.count) {
+    _burst.gap = gap;
+    if (_passing) {
+      _stats.bursts++;
+      if (_burstFunc)
+        _burstFunc(&_burst, _buffer, (_burst.count < SIGNALSEGMENTER_SIZE) ? _burst.count : SIGNALSEGMENTER_SIZE);
+    } else {
+      _stats.dropped++;
+    }
+  } // if
+
+  _burst.count = 0;
+  _passing = false;
+} // _endBurst()
+
+// End.
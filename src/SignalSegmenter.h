@@ -0,0 +1,141 @@
+/**
+ * @file: SignalSegmenter.h
+ *
+ * This file is part of the RFCodes library that implements receiving an sending
+ * RF and IR protocols.
+ *
+ * @copyright Copyright (c) by Matthias Hertel, https://www.mathertel.de.
+ *
+ * This work is licensed under a BSD 3-Clause style license,
+ * https://www.mathertel.de/License.aspx.
+ *
+ * @brief
+ * Optional stage between the SignalCollector and the SignalParser that passes
+ * only bursts of plausible durations to the parser.
+ *
+ * A duration outside of the limits of the loaded protocols doesn't fit to any
+ * code and resets all protocols, see SignalParser::getLimits(). The silence
+ * between transmissions and the short spikes of noise are such durations.
+ * They split the stream into bursts and a burst that is shorter than the
+ * shortest possible sequence can never be decoded. These bursts are dropped
+ * without passing them to the parser so noise costs almost no time.
+ *
+ * The durations of a burst are buffered until it is long enough, then they
+ * are passed to the parser and the following durations of the burst are
+ * passed directly. The decoded sequences are the same as without the
+ * segmenter.
+ *
+ * When a passed burst ends a hook function is called with the burst
+ * information and the first durations of the burst for logging or voting.
+ *
+ * Changelog:
+ * * 16.10.2026 created.
+ */
+
+#ifndef SignalSegmenter_H_
+#define SignalSegmenter_H_
+
+#include "SignalParser.h"
+
+#define SIGNALSEGMENTER_SIZE 128 // buffered durations of a burst
+
+class SignalSegmenter
+{
+public:
+  // Information about a burst of plausible durations.
+  struct Burst {
+    unsigned long index;                // index of the first duration in the stream.
+    unsigned int count;                 // number of durations.
+    unsigned long length;               // sum of the durations in µsecs.
+    SignalParser::CodeTime minDuration; // shortest duration.
+    SignalParser::CodeTime maxDuration; // longest duration.
+    SignalParser::CodeTime gap;         // the duration that ended the burst.
+  };
+
+  // Counters of the segmenter, they wrap around.
+  struct Statistics {
+    unsigned long durations; // all durations.
+    unsigned long passed;    // durations passed to the parser.
+    unsigned long bursts;    // bursts passed to the parser.
+    unsigned long dropped;   // bursts that were too short.
+  };
+
+  // Hook function for a passed burst with the first durations of it.
+  typedef void (*BurstFunction)(const Burst *burst, const SignalParser::CodeTime *durations, int count);
+
+  /** initialize the limits from the protocols loaded into the parser.
+   * @param sig the parser with all protocols loaded.
+   */
+  void init(SignalParser *sig);
+
+  /** narrow the range of plausible durations.
+   * Sequences with durations outside of the range are not decoded any more.
+   * The parser is reset after every passed burst.
+   */
+  void setLimits(SignalParser::CodeTime minTime, SignalParser::CodeTime maxTime);
+
+  /** set the minimal number of durations in a burst, at most SIGNALSEGMENTER_SIZE.
+   * Sequences in shorter bursts are not decoded any more.
+   */
+  void setMinLength(int len);
+
+  /** attach a hook function that is called when a passed burst has ended. */
+  void attachBurstHook(BurstFunction newFunction);
+
+  /** process a single duration.
+   * @param duration the next duration of the stream.
+   */
+  void parse(SignalParser::CodeTime duration);
+
+  /** return the index of the duration in the stream that is passed to the parser
+   * while called from the callback function.
+   */
+  unsigned long getParseIndex()
+  {
+    return (_parseIndex);
+  };
+
+  /** drop the current burst and start with stream index 0. */
+  void reset();
+
+  /** get a copy of the counters. */
+  void getStatistics(Statistics *stats);
+
+  /** reset the counters. */
+  void resetStatistics();
+
+  /** Send the limits and the counters to the output. */
+  void dumpStatistics()
+  {
+    RAW_MSG("Segmenter %u-%u len:%d, dur:%lu passed:%lu bursts:%lu dropped:%lu\n",
+            _minTime, _maxTime, _minLength,
+            _stats.durations, _stats.passed, _stats.bursts, _stats.dropped);
+  } // dumpStatistics()
+
+private:
+  SignalParser *_sig = nullptr;
+  BurstFunction _burstFunc = nullptr;
+
+  SignalParser::CodeTime _minTime = 0;
+  SignalParser::CodeTime _maxTime = (SignalParser::CodeTime)~0;
+  int _minLength = 1;
+  SignalParser::CodeTime _protocolMin = 0; // limits of the protocols.
+  SignalParser::CodeTime _protocolMax = 0;
+
+  SignalParser::CodeTime _buffer[SIGNALSEGMENTER_SIZE];
+  Burst _burst = {};
+  bool _passing = false; // the current burst is passed to the parser.
+  bool _clean = true;    // all protocols of the parser are reset.
+
+  unsigned long _index = 0; // index of the next duration in the stream.
+  unsigned long _parseIndex = 0;
+
+  Statistics _stats = {};
+
+  void _pass(SignalParser::CodeTime duration, unsigned long index);
+  void _endBurst(SignalParser::CodeTime gap);
+}; // class SignalSegmenter
+
+#endif // SignalSegmenter_H_
+
+// End.
@@ -0,0 +1,99 @@
+/**
+ * @file SignalTrace.cpp
+ *
+ * This file is part of the RFCodes library that implements receiving an sending
+ * RF and IR protocols.
+ *
+ * @copyright Copyright (c) by Matthias Hertel, https://www.mathertel.de.
+ *
+ * This work is licensed under a BSD 3-Clause style license,
+ * https://www.mathertel.de/License.aspx.
+ *
+ * @brief
+ * Binary trace ring buffer for the SignalParser.
+ *
+ * Change History see SignalTrace.h
+ */
+
+#include "SignalTrace.h"
+
+#include "debugout.h"
+
+#if (SIGNALTRACE_SIZE & (SIGNALTRACE_SIZE - 1)) != 0
+#error SIGNALTRACE_SIZE must be a power of 2
+#endif
+
+namespace SignalTrace
+{
+
+#if defined(SIGNAL_TRACE)
+
+Record _buffer[SIGNALTRACE_SIZE];
+uint32_t _written = 0;
+bool _enabled = true;
+
+
+void enable(bool on)
+{
+  _enabled = on;
+} // enable()
+
+
+void clear()
+{
+  _written = 0;
+} // clear()
+
+
+uint32_t written()
+{
+  return (_written);
+} // written()
+
+
+int read(Record *buffer, int len)
+{
+  uint32_t cnt = (_written < SIGNALTRACE_SIZE) ? _written : SIGNALTRACE_SIZE;
+  if ((len <= 0) || !buffer)
+    return (0);
+  if ((uint32_t)len < cnt)
+    cnt = len;
+
+  // the oldest record is cnt records before the write position.
+  uint32_t pos = _written - cnt;
+  for (uint32_t n = 0; n < cnt; n++) {
+    *buffer++ = _buffer[pos++ & (SIGNALTRACE_SIZE - 1)];
+  }
+  return ((int)cnt);
+} // read()
+
+
+void dump()
+{
+  uint32_t cnt = (_written < SIGNALTRACE_SIZE) ? _written : SIGNALTRACE_SIZE;
+  uint32_t pos = _written - cnt;
+
+  RAW_MSG("trace %lu records\n", (unsigned long)_written);
+  while (cnt) {
+    Record *r = &_buffer[pos++ & (SIGNALTRACE_SIZE - 1)];
+    RAW_MSG("T:%02x%02x%02x%02x%08lx\n", r->event, r->protocol, (uint8_t)r->code, r->count,
+            (unsigned long)r->duration);
+    cnt--;
+  }
+} // dump()
+
+#else
+
+// tracing is not compiled in.
+
+void enable(bool) {}
+void clear() {}
+uint32_t written() { return (0); }
+int read(Record *, int) { return (0); }
+void dump() {}
+
+#endif
+
+} // namespace SignalTrace
+
+// End.
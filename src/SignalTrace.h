@@ -0,0 +1,130 @@
+/**
+ * @file: SignalTrace.h
+ *
+ * This file is part of the RFCodes library that implements receiving an sending
+ * RF and IR protocols.
+ *
+ * @copyright Copyright (c) by Matthias Hertel, https://www.mathertel.de.
+ *
+ * This work is licensed under a BSD 3-Clause style license,
+ * https://www.mathertel.de/License.aspx.
+ *
+ * @brief
+ * Binary trace ring buffer for the SignalParser.
+ *
+ * Printing trace messages on every duration takes much longer than the
+ * durations themselves and destroys the timing. Instead the parser writes small
+ * binary records into a fixed size ring buffer in memory that keeps the latest
+ * events. The buffer can be stopped after a misdecode and dumped later:
+ *
+ * ```CPP
+ * void receiveCode(const char *code) {
+ *   if (unexpected(code)) {
+ *     SignalTrace::enable(false); // keep the events that lead to this code.
+ *     SignalTrace::dump();
+ *   }
+ * }
+ * ```
+ *
+ * The dump can be decoded on the host using the rftrace tool in extras.
+ *
+ * Tracing is compiled in only when SIGNAL_TRACE is defined, here or by the
+ * build flags. Otherwise the TRACE_EVENT macro produces no code and no memory
+ * is used.
+ *
+ * Changelog:
+ * * 16.10.2026 created.
+ * * 16.10.2026 REJECT event of the validate functions.
+ */
+
+#ifndef SignalTrace_H_
+#define SignalTrace_H_
+
+// #define SIGNAL_TRACE
+
+#include <stdint.h>
+
+#ifndef SIGNALTRACE_SIZE
+#define SIGNALTRACE_SIZE 256 // number of records in the ring buffer, must be a power of 2
+#endif
+
+#define SIGNALTRACE_NOPROTOCOL 0xFF // protocol index of events not related to a protocol
+
+/** namespace for the trace ring buffer. */
+namespace SignalTrace
+{
+
+// Events written by the SignalParser.
+enum Event : uint8_t {
+  DURATION = 1, // a new duration is parsed, count: number of loaded protocols.
+  MATCH,        // a timing of a code matches, count: number of matched timings of the code.
+  RETRY,        // the duration is reanalyzed as a first duration for starting.
+  SYMBOL,       // a code was added to the sequence, count: length of the sequence.
+  FRAGMENT,     // an end code was found before minCodeLen, count: length of the sequence.
+  FRAME,        // a complete sequence was passed to the callback, count: length of the sequence.
+  RESET,        // no code fits and a started sequence is dropped, count: length of the sequence.
+  REJECT        // a complete sequence was dropped by the validate function, count: length of the sequence.
+};
+
+// A single trace record of 8 bytes.
+struct Record {
+  uint8_t event;     // Event
+  uint8_t protocol;  // index of the protocol in the order of load()
+  char code;         // name of the code or NUL
+  uint8_t count;     // event specific count
+  uint32_t duration; // the current duration in µsecs
+};
+
+#if defined(SIGNAL_TRACE)
+
+// The ring buffer and its state. Use the functions below.
+extern Record _buffer[SIGNALTRACE_SIZE];
+extern uint32_t _written;
+extern bool _enabled;
+
+/** write a record into the ring buffer, overwriting the oldest record. */
+inline void write(Event event, uint8_t protocol, char code, uint8_t count, uint32_t duration)
+{
+  if (_enabled) {
+    Record *r = &_buffer[_written++ & (SIGNALTRACE_SIZE - 1)];
+    r->event = event;
+    r->protocol = protocol;
+    r->code = code;
+    r->count = count;
+    r->duration = duration;
+  }
+} // write()
+
+#define TRACE_EVENT(event, protocol, code, count, duration) \
+  SignalTrace::write(SignalTrace::event, (uint8_t)(protocol), (code), (uint8_t)(count), (duration))
+
+#else
+
+#define TRACE_EVENT(event, protocol, code, count, duration)
+
+#endif
+
+/** start or stop writing records. Tracing is enabled by default. */
+void enable(bool on);
+
+/** remove all records. */
+void clear();
+
+/** number of records written since clear(), including the overwritten ones. */
+uint32_t written();
+
+/** copy the records from the ring buffer, the oldest first.
+ * @param buffer target buffer.
+ * @param len size of the buffer in records.
+ * @return number of copied records.
+ */
+int read(Record *buffer, int len);
+
+/** print the records using RAW_MSG as hex text lines that can be decoded by rftrace. */
+void dump();
+
+} // namespace SignalTrace
+
+#endif // SignalTrace_H_
+
+// End.
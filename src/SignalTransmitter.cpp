@@ -0,0 +1,271 @@
+/**
+ * @file SignalTransmitter.cpp
+ *
+ * This file is part of the RFCodes library that implements receiving an sending
+ * RF and IR protocols.
+ *
+ * @copyright Copyright (c) by Matthias Hertel, https://www.mathertel.de.
+ *
+ * This work is licensed under a BSD 3-Clause style license,
+ * https://www.mathertel.de/License.aspx.
+ *
+ * @brief
+ * Transmitter that sends the timings of a sequence from a timer interrupt or
+ * blocking when no timer is available.
+ *
+ * Change History see SignalTransmitter.h
+ */
+
+#include <string.h>
+
+#include "SignalTransmitter.h"
+
+SignalTransmitter *volatile SignalTransmitter::_active = nullptr;
+
+
+/** Initialize the sending pin. */
+void SignalTransmitter::init(SignalParser *sig, int sendPin)
+{
+  _sig = sig;
+  _sendPin = sendPin;
+  if (sendPin >= 0) {
+    SignalHal::pinOutput(_sendPin);
+    SignalHal::writePin(_sendPin, LOW);
+  }
+} // init()
+
+
+/** add a sequence to the queue. */
+bool SignalTransmitter::send(const char *code)
+{
+  SignalParser::Handle handle;
+
+  if (!_sig || (_sig->compile(code, &handle) <= 0))
+    return (false);
+  return (send(&handle));
+} // send()
+
+
+/** add a compiled sequence to the queue. */
+bool SignalTransmitter::send(const SignalParser::Handle *handle)
+{
+  if (!handle || !handle->protocol || (handle->length <= 0) || (_sendPin < 0) || (_count >= ST_QUEUE_SIZE))
+    return (false);
+
+  SignalParser::Protocol *p = handle->protocol;
+  if (p->sendRepeat <= 0)
+    return (false);
+
+  // the gap must not fit to any code of the protocol even when distorted.
+  SignalParser::CodeTime minTime = (SignalParser::CodeTime)~0;
+  SignalParser::CodeTime maxTime = 0;
+  for (int c = 0; c < p->codeLength; c++) {
+    for (int t = 0; t < p->codes[c].timeLength; t++) {
+      SignalParser::CodeTime time = (p->codes[c].minTime[t] + p->codes[c].maxTime[t]) / 2;
+      if (time < minTime)
+        minTime = time;
+      if (p->codes[c].maxTime[t] > maxTime)
+        maxTime = p->codes[c].maxTime[t];
+    }
+  } // for
+  if (p->manchester) {
+    if (p->baseTime < minTime)
+      minTime = p->baseTime;
+    if (p->halfMax[1] > maxTime)
+      maxTime = p->halfMax[1];
+  }
+
+  Job *job = &_queue[_count];
+  job->handle = *handle;
+  job->pulse = minTime;
+  job->gap = 2 * maxTime;
+  job->repeat = p->sendRepeat;
+  memset(&job->info, 0, sizeof(SendInfo));
+  job->info.enqueued = SignalHal::getMicros();
+  _count++;
+
+  if (!_busy && !_finished)
+    _startCopy();
+  return (true);
+} // send()
+
+
+/** stop sending immediately and clear the queue. */
+void SignalTransmitter::abort()
+{
+  SignalHal::disableInterrupts();
+  if (_busy) {
+    _busy = false;
+    _active = nullptr;
+    SignalHal::writePin(_sendPin, LOW);
+  }
+  _finished = false;
+  SignalHal::enableInterrupts();
+
+  if (_useTimer)
+    SignalHal::detachTimer();
+  _count = 0;
+  _current = -1;
+  _next = 0;
+} // abort()
+
+
+/** attach a callback function that is called from loop() after sending a sequence. */
+void SignalTransmitter::attachSentCallback(SentFunction newFunction)
+{
+  _sentFunc = newFunction;
+} // attachSentCallback()
+
+
+/** start the next copy and report the end of sending. */
+void SignalTransmitter::loop()
+{
+  if (_finished) {
+    _finished = false;
+    _endCopy();
+  }
+
+  if (!_busy && !_finished && (_count > 0))
+    _startCopy();
+} // loop()
+
+
+// start sending the next copy.
+void SignalTransmitter::_startCopy()
+{
+  if (_active)
+    return; // the timer is used by another transmitter.
+
+  if (_count > 0) {
+    // sequences that have not been sent yet first, then round-robin.
+    int n = 0;
+    while ((n < _count) && (_queue[n].info.repeats > 0))
+      n++;
+    if (n == _count)
+      n = (_next < _count) ? _next : 0;
+    _next = (n + 1 < _count) ? n + 1 : 0;
+
+    Job *job = &_queue[n];
+
+    // the queue is not changed while sending so the encoder can use the handle.
+    _encoder.begin(&job->handle);
+    _pulse = job->pulse;
+    _gap = job->gap;
+
+    if (job->info.repeats == 0)
+      job->info.started = SignalHal::getMicros();
+    job->info.repeats++;
+    job->repeat--;
+    _current = n;
+
+    _pos = 0;
+    _tail = 0;
+    _level = LOW; // LOW level before starting.
+    _busy = true;
+    _active = this;
+    _useTimer = SignalHal::attachTimer(_timerHandler);
+    _due = SignalHal::getMicros();
+
+    SignalHal::disableInterrupts();
+    _edge();
+    SignalHal::enableInterrupts();
+
+    if (!_useTimer) {
+      // no timer: write the edges of the copy with busy waiting.
+      while (_busy) {
+        long wait = (long)(_due - SignalHal::getMicros());
+        if (wait > 0)
+          SignalHal::delayMicros(wait);
+        _edge();
+      }
+    } // if
+  } // if
+} // _startCopy()
+
+
+// handle the end of a copy.
+void SignalTransmitter::_endCopy()
+{
+  int n = _current;
+  _current = -1;
+
+  if ((n >= 0) && (n < _count) && (_queue[n].repeat <= 0)) {
+    // all copies are sent, the callback may add new sequences and start sending them.
+    Job job = _queue[n];
+    job.info.completed = SignalHal::getMicros();
+    _remove(n);
+    if (_sentFunc) {
+      char code[ST_CODE_LEN];
+      SignalParser::getText(&job.handle, code, ST_CODE_LEN);
+      _sentFunc(code, &job.info);
+    }
+  }
+
+  if ((_count == 0) && _useTimer && !_active)
+    SignalHal::detachTimer();
+} // _endCopy()
+
+
+// remove a sequence from the queue.
+void SignalTransmitter::_remove(int n)
+{
+  _count--;
+  for (int i = n; i < _count; i++) {
+    _queue[i] = _queue[i + 1];
+  }
+
+  if (n < _next)
+    _next--;
+  if (_next >= _count)
+    _next = 0;
+} // _remove()
+
+
+// write the next edge and arm the timer for its duration.
+void IRAM_ATTR SignalTransmitter::_edge()
+{
+  SignalParser::CodeTime t = 0;
+
+  if (_tail == 0) {
+    t = _encoder.next();
+    if (t == 0)
+      _tail = 1;
+  }
+
+  if (_tail == 1) {
+    if ((_pos % 2) == 0) {
+      // a short pulse to end the last low duration.
+      t = _pulse;
+    } else {
+      t = _gap;
+      _tail = 2;
+    }
+  } // if
+
+  if (t == 0) {
+    // never leave active after sending.
+    SignalHal::writePin(_sendPin, LOW);
+    _busy = false;
+    _finished = true;
+    _active = nullptr;
+    return;
+  }
+
+  _pos = _pos + 1;
+  _level = !_level;
+  _due = _due + t;
+  if (_useTimer)
+    SignalHal::armTimer(t);
+  SignalHal::writePin(_sendPin, _level);
+} // _edge()
+
+
+// This handler is attached to the timer.
+void IRAM_ATTR SignalTransmitter::_timerHandler()
+{
+  SignalTransmitter *t = _active;
+  if (t)
+    t->_edge();
+} // _timerHandler()
+
+// End.
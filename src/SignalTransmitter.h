@@ -0,0 +1,183 @@
+/**
+ * @file: SignalTransmitter.h
+ *
+ * This file is part of the RFCodes library that implements receiving an sending
+ * RF and IR protocols.
+ *
+ * @copyright Copyright (c) by Matthias Hertel, https://www.mathertel.de.
+ *
+ * This work is licensed under a BSD 3-Clause style license,
+ * https://www.mathertel.de/License.aspx.
+ *
+ * @brief
+ * Transmitter that sends the timings of a sequence from a timer interrupt or
+ * blocking when no timer is available.
+ *
+ * send() adds the sequence to a queue and returns. A sequence that is sent
+ * often can be compiled once by SignalParser::compile() and sent by its
+ * handle without searching the protocol and the codes. loop() starts the
+ * next copy, sets the first level and arms the one-shot timer of the
+ * SignalHal that writes every following edge, so the main loop, WiFi and
+ * receiving go on while sending. The timings are encoded one by one while
+ * sending by a SignalParser::Encoder, so there is no limit for the length of a
+ * sequence.
+ *
+ * The copies of all queued sequences are interleaved round-robin. Sequences
+ * that have not been sent yet come first so every code is on air early.
+ * Every copy is followed by a gap of silence that is twice as long as the
+ * longest timing of the protocol including the tolerance. When the copy ends
+ * with a low level a short pulse is sent before the gap to end the last
+ * duration.
+ *
+ * The end of sending a sequence with all repeats is reported by the sent
+ * callback function from loop() with the enqueue, start and completion
+ * times.
+ *
+ * On boards without a timer backend like AVR, see SignalHal.h, every copy is
+ * sent blocking with busy waiting like the former send() when it is started
+ * by send() or loop(). The queue and the round-robin order of the repeats are
+ * the same. ESP8266 and ESP32 always use a timer.
+ *
+ * Changelog:
+ * * 16.10.2026 created.
+ * * 16.10.2026 queue with round-robin repeats and gaps.
+ * * 16.10.2026 send compiled sequences.
+ * * 16.10.2026 encode the timings in the interrupt without a buffer.
+ * * 16.10.2026 pulse and gap of manchester protocols.
+ * * 16.10.2026 send() from the sent callback.
+ * * 16.10.2026 blocking copies without a timer.
+ * * 16.10.2026 queue size per platform.
+ * * 16.10.2026 blocking only on boards without a timer backend.
+ */
+
+#ifndef SignalTransmitter_H_
+#define SignalTransmitter_H_
+
+#include "SignalHal.h"
+
+#include "SignalParser.h"
+
+#define ST_CODE_LEN (PROTNAME_LEN + MAX_SEQUENCE_LENGTH) // maximal length of a sequence text
+
+// maximal number of queued sequences. Every entry holds a compiled sequence
+// of about 150 bytes, so the boards use a small queue.
+#ifndef ST_QUEUE_SIZE
+#if defined(ARDUINO_ARCH_AVR)
+#define ST_QUEUE_SIZE 2
+#elif defined(ARDUINO)
+#define ST_QUEUE_SIZE 4
+#else
+#define ST_QUEUE_SIZE 16
+#endif
+#endif
+
+class SignalTransmitter
+{
+public:
+  // Times of a sent sequence in µsecs.
+  struct SendInfo {
+    unsigned long enqueued;  // send() was called.
+    unsigned long started;   // the first copy was started.
+    unsigned long completed; // the gap after the last copy has ended.
+    int repeats;             // number of sent copies.
+  };
+
+  // Callback function that gets the sent sequence.
+  typedef void (*SentFunction)(const char *code, const SendInfo *info);
+
+  /** Initialize the sending pin.
+   * @param sig the parser with the protocols used for composing the timings.
+   * @param sendPin the IO pin used for sending.
+   */
+  void init(SignalParser *sig, int sendPin);
+
+  /** add a sequence to the queue that is sent with the number of repeats of the protocol.
+   * @param code textual representation using "<protocolname> <codes>".
+   * @return true when the sequence was queued, false when the queue is full or the sequence is not valid, see SignalParser::compile().
+   */
+  bool send(const char *code);
+
+  /** add a compiled sequence to the queue that is sent with the number of repeats of the protocol.
+   * @param handle the sequence compiled by SignalParser::compile(), it is copied into the queue.
+   * @return true when the sequence was queued, false when the queue is full or the handle is empty.
+   */
+  bool send(const SignalParser::Handle *handle);
+
+  /** stop sending immediately and clear the queue. */
+  void abort();
+
+  /** attach a callback function that is called from loop() after sending a sequence. */
+  void attachSentCallback(SentFunction newFunction);
+
+  /** return true until the end of sending all queued sequences was reported by loop(). */
+  bool isSending()
+  {
+    return (_count > 0);
+  };
+
+  /** return the number of sequences in the queue including the one on air. */
+  int getQueueDepth()
+  {
+    return (_count);
+  };
+
+  /** return true while a transmitter is writing edges. */
+  static bool isActive()
+  {
+    return (_active != nullptr);
+  };
+
+  /** start the next copy and report the end of sending. */
+  void loop();
+
+private:
+  struct Job {
+    SignalParser::Handle handle;
+    SignalParser::CodeTime pulse; // shortest timing of the protocol.
+    SignalParser::CodeTime gap;   // silence after every copy.
+    int repeat;                 // remaining copies.
+    SendInfo info;
+  };
+
+  static SignalTransmitter *volatile _active; // the transmitter using the timer.
+
+  SignalParser *_sig = nullptr;
+  int _sendPin = -1;
+  SentFunction _sentFunc = nullptr;
+  bool _useTimer = false;
+
+  Job _queue[ST_QUEUE_SIZE];
+  int _count = 0;    // number of queued sequences.
+  int _current = -1; // index of the sequence on air.
+  int _next = 0;     // index of the next sequence in round-robin order.
+
+  SignalParser::Encoder _encoder;   // timings of the copy on air.
+  SignalParser::CodeTime _pulse = 0; // pulse and gap after the copy.
+  SignalParser::CodeTime _gap = 0;
+
+  volatile int _pos = 0;           // number of written timings.
+  volatile int _tail = 0;          // 0: encoding, 1: pulse and gap, 2: done.
+  volatile int _level = LOW;       // current output level.
+  volatile unsigned long _due = 0; // time of the next edge.
+  volatile bool _busy = false;     // edges are written.
+  volatile bool _finished = false; // a copy has ended but is not yet handled by loop().
+
+  // start sending the next copy.
+  void _startCopy();
+
+  // handle the end of a copy.
+  void _endCopy();
+
+  // remove a sequence from the queue.
+  void _remove(int n);
+
+  // write the next edge and arm the timer for its duration.
+  void IRAM_ATTR _edge();
+
+  // This handler is attached to the timer.
+  static void IRAM_ATTR _timerHandler();
+}; // class SignalTransmitter
+
+#endif // SignalTransmitter_H_
+
+// End.
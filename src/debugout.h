@@ -24,21 +24,23 @@
 #define TRACE_MSG(fmt, ...)
 #define RAW_MSG(...)
 
+#elif !defined(ARDUINO)
+// host systems use stdout and stderr
+#include <stdio.h>
+#define ERROR_MSG(...) { fprintf(stderr, "[error] " __VA_ARGS__); fputc('\n', stderr); }
+#define INFO_MSG(...)  { fprintf(stderr, "[info]  " __VA_ARGS__); fputc('\n', stderr); }
+#define TRACE_MSG(...) { fprintf(stderr, "[trace] " __VA_ARGS__); fputc('\n', stderr); }
+#define RAW_MSG(...)   { fprintf(stdout, __VA_ARGS__); }
+
 #else
 #define ERROR_MSG(fmt, ...)
 #define INFO_MSG(fmt, ...)
 #define TRACE_MSG(fmt, ...)
 #define RAW_MSG(...)
 
-// #include <cstdio>
-// // stdout version
-// #define ERROR_MSG(fmt, ...) fprintf(stderr, "[error] " fmt "\n", __VA_ARGS__);
-// #define INFO_MSG(fmt, ...) fprintf(stderr, "[info]  " fmt "\n", __VA_ARGS__);
-// #define TRACE_MSG(fmt, ...) fprintf(stderr, "[trace] " fmt "\n", __VA_ARGS__);
-// #define RAW_MSG(...)   fprintf(stderr, __VA_ARGS__);
-
 #endif
 
+// printing on every duration destroys the timing, see SignalTrace.h for tracing the parser.
 #undef TRACE_MSG
 #define TRACE_MSG(...)
 
@@ -0,0 +1,50 @@
+// ircodes.cpp
+
+// Definitions of the infrared protocols declared in ircodes.h.
+// See ircodes.h for the descriptions and the encode functions.
+
+#include "ircodes.h"
+
+namespace IRCodes
+{
+
+SignalParser::Protocol nec = {
+    "nec",
+    .minCodeLen = 1,
+    .maxCodeLen = 1 + 32,
+
+    .tolerance = 20,
+    .sendRepeat = 4,
+    .baseTime = 560,
+    .codes = {
+        // starting sequence is /‾‾(9000)‾‾\__(4500)__/
+        {SignalParser::CodeType::START, 'N', {16, 8}},
+
+        // low signal is /‾\_/
+        {SignalParser::CodeType::DATA, '0', {1, 1}},
+
+        // high signal is /‾\___/
+        {SignalParser::CodeType::DATA, '1', {1, 3}},
+
+        // Repeat signal is /‾‾(9000)‾‾\__(2250)__/ and a complete sequence.
+        {SignalParser::CodeType::SINGLE, 'R', {16, 4}}},
+    .validate = SignalDecoder::validateNec};
+
+
+SignalParser::Protocol rc5 = {
+    "rc5",
+    .minCodeLen = 1 + 13,
+    .maxCodeLen = 1 + 13,
+
+    .tolerance = 20,
+    .sendRepeat = 3,
+    .baseTime = 889,
+    .codes = {
+        // second half of the first start bit /‾\_
+        {SignalParser::CodeType::START, 'S', {1}}},
+    .validate = nullptr,
+    .manchester = SignalParser::MANCHESTER | SignalParser::MANCHESTER_INVERT};
+
+} // namespace IRCodes
+
+// End.
@@ -3,6 +3,18 @@
 // https://www.sbprojects.net/knowledge/ir/nec.php
 // https://techdocs.altium.com/display/FPGA/NEC+Infrared+Transmission+Protocol
 
+// The protocols are declared here and defined in ircodes.cpp so this file can be
+// included in multiple translation units of a program.
+
+// The rc5 protocol is received in the manchester mode of the parser, see SignalParser::ManchesterMode.
+// address 5 and command 12: [rc5 S1000101001100]
+
+// A held button sends the repeat code R that is received as "nec R".
+// The SignalDecoder reports it as the last command with a repeat counter.
+
+// encodeNec() builds a compiled sequence from values without a text.
+// The protocol must be loaded before the sequence is sent.
+
 
 // typical recording: [nec N00000000 11110111 11010000 00101111]
 // 9193,4530,
@@ -29,6 +41,7 @@
 #ifndef SignalParser_IRCODES_H_
 #define SignalParser_IRCODES_H_
 
+#include "SignalDecoder.h"
 #include "SignalParser.h"
 
 /** namespace for defining codes for the Arduino RFCodes library. */
@@ -38,26 +51,51 @@ namespace IRCodes
 // Definition of the IR protocol used / defined by nec.
 // Timings from // https://www.sbprojects.net/knowledge/ir/nec.php
 
-SignalParser::Protocol nec = {
-    "nec",
-    .minCodeLen = 1,
-    .maxCodeLen = 1 + 32,
-
-    .tolerance = 20,
-    .sendRepeat = 4,
-    .baseTime = 560,
-    .codes = {
-        // starting sequence is /‾‾(9000)‾‾\__(4500)__/
-        {SignalParser::CodeType::START, 'N', {16, 8}},
+extern SignalParser::Protocol nec;
 
-        // low signal is /‾\_/
-        {SignalParser::CodeType::DATA, '0', {1, 1}},
-
-        // high signal is /‾\___/
-        {SignalParser::CodeType::DATA, '1', {1, 3}},
-
-        // Repeat signal is /‾‾(9000)‾‾\__(2250)__/
-        {SignalParser::CodeType::DATA, 'R', {16, 4}}}};
+/** build a nec sequence, every byte is sent with the lowest bit first.
+ * @param address 8 bit address sent with the inverted byte or 16 bit extended address.
+ * @param command 8 bit command sent with the inverted byte.
+ * @return the number of codes or a SignalParser::ComposeError.
+ */
+inline int encodeNec(SignalParser::Handle *handle, unsigned int address, unsigned int command)
+{
+  if (address <= 0xFF)
+    address |= (~address & 0xFF) << 8;
+  command = (command & 0xFF) | ((~command & 0xFF) << 8);
+
+  SignalParser::begin(handle, &nec);
+  bool ok = SignalParser::append(handle, 'N');
+  ok = ok && SignalParser::appendBits(handle, address, 16, '0', '1', true);
+  ok = ok && SignalParser::appendBits(handle, command, 16, '0', '1', true);
+  return (ok ? handle->length : SignalParser::COMPOSE_CODE);
+} // encodeNec()
+
+
+// Definition of the philips rc5 IR protocol using manchester bits with a half bit time of 889 µsecs.
+// The first half of the first start bit is not visible so the start code is the second half.
+// The second start bit, the toggle bit, 5 address bits and 6 command bits follow, highest bit first.
+// A 1 bit is sent as low-high. The extended rc5 with an inverted second start bit is not supported.
+// Timings from https://www.sbprojects.net/knowledge/ir/rc5.php
+
+extern SignalParser::Protocol rc5;
+
+/** build a rc5 sequence.
+ * @param address 5 bit address.
+ * @param command 6 bit command.
+ * @param toggle the toggle bit that changes with every press of a button.
+ * @return the number of codes or a SignalParser::ComposeError.
+ */
+inline int encodeRc5(SignalParser::Handle *handle, unsigned int address, unsigned int command, bool toggle)
+{
+  SignalParser::begin(handle, &rc5);
+  bool ok = SignalParser::append(handle, 'S');
+  ok = ok && SignalParser::append(handle, '1');
+  ok = ok && SignalParser::append(handle, toggle ? '1' : '0');
+  ok = ok && SignalParser::appendBits(handle, address, 5, '0', '1');
+  ok = ok && SignalParser::appendBits(handle, command, 6, '0', '1');
+  return (ok ? handle->length : SignalParser::COMPOSE_CODE);
+} // encodeRc5()
 
 } // namespace IRCodes
 
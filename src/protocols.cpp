@@ -0,0 +1,75 @@
+// protocols.cpp
+
+// Definitions of the 433 MHz protocols declared in protocols.h.
+// See protocols.h for the descriptions and the encode functions.
+
+#include "protocols.h"
+
+namespace RFCodes
+{
+
+SignalParser::Protocol it1 = {
+    "it1",
+    .minCodeLen = 1 + 12,
+    .maxCodeLen = 1 + 12,
+
+    .tolerance = 25,
+    .sendRepeat = 4,
+    .baseTime = 400,
+    .codes = {
+        {SignalParser::CodeType::START, 'B', {1, 31}},
+        {SignalParser::CodeType::DATA, '0', {1, 3, 3, 1}},
+        {SignalParser::CodeType::DATA, '1', {1, 3, 1, 3}}}
+
+};
+
+
+SignalParser::Protocol it2 = {
+    "it2", // .name =
+    .minCodeLen = 34,
+    .maxCodeLen = 48,
+
+    .tolerance = 25,
+    .sendRepeat = 10,
+    .baseTime = 280, // base time in µsecs
+    .codes = {
+        {SignalParser::CodeType::START, 's', {1, 10}},
+        {SignalParser::CodeType::DATA, '_', {1, 1, 1, 5}},
+        {SignalParser::CodeType::DATA, '#', {1, 5, 1, 1}},
+        {SignalParser::CodeType::DATA, 'D', {1, 1, 1, 1}},
+        {SignalParser::CodeType::END, 'x', {1, 38}}}
+
+};
+
+
+SignalParser::Protocol sc5 = {
+    "sc5",
+    .minCodeLen = 1 + 12,
+    .maxCodeLen = 1 + 12,
+
+    .tolerance = 25,
+    .sendRepeat = 3,
+    .baseTime = 100,
+    .codes = {
+        {SignalParser::CodeType::ANYDATA, '0', {4, 12, 4, 12}},
+        {SignalParser::CodeType::ANYDATA, '1', {12, 4, 12, 4}},
+        {SignalParser::CodeType::ANYDATA, 'f', {4, 12, 12, 4}},
+        {SignalParser::CodeType::END, 'S', {4, 124}}}};
+
+
+SignalParser::Protocol cw = {
+    "cw",
+    .minCodeLen = 59,
+    .maxCodeLen = 59,
+
+    .tolerance = 16,
+    .sendRepeat = 3,
+    .baseTime = 500,
+    .codes = {
+        {SignalParser::CodeType::START, 'H', {2, 2, 2, 2, 2}}},
+    .validate = SignalDecoder::validateCw,
+    .manchester = SignalParser::MANCHESTER | SignalParser::MANCHESTER_MID};
+
+} // namespace RFCodes
+
+// End.
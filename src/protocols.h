@@ -2,9 +2,17 @@
 
 // This is a collection of protocol definitions used in the 433 MHz Band for remote controls and data transfers.
 
+// The protocols are declared here and defined in protocols.cpp so this file can be
+// included in multiple translation units of a program.
+
+// The encode functions build a compiled sequence from values without a text.
+// The protocol must be loaded before the sequence is sent.
+// They return the number of codes or a SignalParser::ComposeError.
+
 #ifndef SignalParser_PROTOCOLS_H_
 #define SignalParser_PROTOCOLS_H_
 
+#include "SignalDecoder.h"
 #include "SignalParser.h"
 
 /** namespace for defining codes for the Arduino RFCodes library. */
@@ -12,71 +20,94 @@ namespace RFCodes
 {
 
 /** Definition of the "older" intertechno protocol with fixed 12 bits of data */
-SignalParser::Protocol it1 = {
-    "it1",
-    .minCodeLen = 1 + 12,
-    .maxCodeLen = 1 + 12,
-
-    .tolerance = 25,
-    .sendRepeat = 4,
-    .baseTime = 400,
-    .codes = {
-        {SignalParser::CodeType::START, 'B', {1, 31}},
-        {SignalParser::CodeType::DATA, '0', {1, 3, 3, 1}},
-        {SignalParser::CodeType::DATA, '1', {1, 3, 1, 3}}}
+extern SignalParser::Protocol it1;
 
-};
+/** build an it1 sequence from the settings of the 10 DIP switches.
+ * @param dips bit 0 is the first switch, a set bit sends '1'.
+ * @param on true for sending the on command.
+ */
+inline int encodeIt1(SignalParser::Handle *handle, unsigned int dips, bool on)
+{
+  SignalParser::begin(handle, &it1);
+  bool ok = SignalParser::append(handle, 'B');
+  ok = ok && SignalParser::appendBits(handle, dips, 10, '0', '1', true);
+  ok = ok && SignalParser::append(handle, '0');
+  ok = ok && SignalParser::append(handle, on ? '0' : '1');
+  return (ok ? handle->length : SignalParser::COMPOSE_CODE);
+} // encodeIt1()
 
 
 /** Definition of the "newer" intertechno protocol with 32 - 46 data bits data */
-SignalParser::Protocol it2 = {
-    "it2", // .name =
-    .minCodeLen = 34,
-    .maxCodeLen = 48,
-
-    .tolerance = 25,
-    .sendRepeat = 10,
-    .baseTime = 280, // base time in µsecs
-    .codes = {
-        {SignalParser::CodeType::START, 's', {1, 10}},
-        {SignalParser::CodeType::DATA, '_', {1, 1, 1, 5}},
-        {SignalParser::CodeType::DATA, '#', {1, 5, 1, 1}},
-        {SignalParser::CodeType::DATA, 'D', {1, 1, 1, 1}},
-        {SignalParser::CodeType::END, 'x', {1, 38}}}
-
-};
+extern SignalParser::Protocol it2;
+
+/** build an it2 on/off sequence.
+ * @param address the 26 bit id of the sender.
+ * @param group true to address all receivers.
+ * @param on true for sending the on command.
+ * @param unit the unit or button 0..15.
+ */
+inline int encodeIt2(SignalParser::Handle *handle, unsigned long address, bool group, bool on, unsigned int unit)
+{
+  SignalParser::begin(handle, &it2);
+  bool ok = SignalParser::append(handle, 's');
+  ok = ok && SignalParser::appendBits(handle, address, 26, '_', '#');
+  ok = ok && SignalParser::append(handle, group ? '#' : '_');
+  ok = ok && SignalParser::append(handle, on ? '#' : '_');
+  ok = ok && SignalParser::appendBits(handle, unit, 4, '_', '#');
+  ok = ok && SignalParser::append(handle, 'x');
+  return (ok ? handle->length : SignalParser::COMPOSE_CODE);
+} // encodeIt2()
 
 
 /** Definition of the protocol from SC5272 and similar chips with 32 - 46 data bits data */
-SignalParser::Protocol sc5 = {
-    "sc5",
-    .minCodeLen = 1 + 12,
-    .maxCodeLen = 1 + 12,
-
-    .tolerance = 25,
-    .sendRepeat = 3,
-    .baseTime = 100,
-    .codes = {
-        {SignalParser::CodeType::ANYDATA, '0', {4, 12, 4, 12}},
-        {SignalParser::CodeType::ANYDATA, '1', {12, 4, 12, 4}},
-        {SignalParser::CodeType::ANYDATA, 'f', {4, 12, 12, 4}},
-        {SignalParser::CodeType::END, 'S', {4, 124}}}};
-
-
-/** register the cresta protocol with a length of 59 codes; used for sensor data transmissions.
+extern SignalParser::Protocol sc5;
+
+/** build a sc5 sequence from the 12 tri-state address and data pins.
+ * @param high bit 0 is the first pin, a set bit sends '1'.
+ * @param open pins that are not connected and send 'f'.
+ */
+inline int encodeSc5(SignalParser::Handle *handle, unsigned int high, unsigned int open)
+{
+  SignalParser::begin(handle, &sc5);
+  bool ok = true;
+  for (int n = 0; n < 12; n++) {
+    char code = ((open >> n) & 1) ? 'f' : ((high >> n) & 1) ? '1' : '0';
+    ok = ok && SignalParser::append(handle, code);
+  }
+  ok = ok && SignalParser::append(handle, 'S');
+  return (ok ? handle->length : SignalParser::COMPOSE_CODE);
+} // encodeSc5()
+
+
+/** register the cresta protocol with the start code and 58 manchester bits; used for sensor data transmissions.
+ * The start code ends in the middle of the 5. bit with a half bit time of 500 µsecs.
  * See /docs/cresta_protocol.h */
-SignalParser::Protocol cw = {
-    "cw",
-    .minCodeLen = 59,
-    .maxCodeLen = 59,
-
-    .tolerance = 16,
-    .sendRepeat = 3,
-    .baseTime = 500,
-    .codes = {
-        {SignalParser::CodeType::START, 'H', {2, 2, 2, 2, 2}},
-        {SignalParser::CodeType::DATA, 's', {1, 1}},
-        {SignalParser::CodeType::DATA, 'l', {2}}}};
+extern SignalParser::Protocol cw;
+
+/** build a cw sequence from the 7 data bytes, the first byte is always sent as 0x9f.
+ * The bits are sent with the lowest bit first and a 0 bit between the bytes
+ * using manchester codes, see SignalDecoder::decodeCw().
+ */
+inline int encodeCw(SignalParser::Handle *handle, const uint8_t *data)
+{
+  SignalParser::begin(handle, &cw);
+  bool ok = SignalParser::append(handle, 'H');
+
+  uint8_t level = 0x1; // the start code ends with the first 5 bits of 0x9f.
+  for (int n = 0; n < 7; n++) {
+    for (int b = (n == 0) ? 5 : 0; b <= 8; b++) {
+      int bit = 0; // bit 8 is the 0 bit between the bytes.
+      if (b < 8) {
+        // the level changes for every 1 bit of the data.
+        level ^= (data[n] >> b) & 1;
+        bit = level;
+      }
+      ok = ok && SignalParser::append(handle, bit ? '1' : '0');
+    } // for
+    level = 0;
+  } // for
+  return (ok ? handle->length : SignalParser::COMPOSE_CODE);
+} // encodeCw()
 
 } // namespace RFCodes
 